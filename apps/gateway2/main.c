@@ -137,6 +137,7 @@ static void Initialize_Device_Addresses(void)
     int i = 0; /* First entry is Gateway Device */
     uint32_t virtual_mac = 0;
     BACNET_ADDRESS virtual_address = { 0 };
+    BACNET_ADDRESS device_address = { 0 };
     DEVICE_OBJECT_DATA *pDev = NULL;
     /* Setup info for the main gateway device first */
     pDev = Get_Routed_Device_Object(i);
@@ -157,7 +158,7 @@ static void Initialize_Device_Addresses(void)
 #else
 #error "No support for this Data Link Layer type "
 #endif
-    bacnet_address_copy(&pDev->bacDevAddr, &virtual_address);
+    Routed_Device_Set_Address(i, &virtual_address);
     /* broadcast an I-Am on startup */
     Send_I_Am(&Handler_Transmit_Buffer[0]);
 
@@ -168,13 +169,15 @@ static void Initialize_Device_Addresses(void)
             continue;
         }
         /* start with the router address */
-        bacnet_address_copy(&pDev->bacDevAddr, &virtual_address);
+        bacnet_address_copy(&device_address, &virtual_address);
         /* add the network number to each gateway device */
-        pDev->bacDevAddr.net = VIRTUAL_DNET;
+        device_address.net = VIRTUAL_DNET;
         /* use a virtual MAC for each gateway device */
         virtual_mac = pDev->bacObj.Object_Instance_Number;
-        encode_unsigned24(&pDev->bacDevAddr.adr[0], virtual_mac);
-        pDev->bacDevAddr.len = 3;
+        encode_unsigned24(&device_address.adr[0], virtual_mac);
+        device_address.len = 3;
+        /* keeps the virtual MAC lookup up to date */
+        Routed_Device_Set_Address(i, &device_address);
     }
 }
 
@@ -828,11 +828,8 @@ static bool read_received_packet(struct mstp_port_struct_t *mstp_port)
                 File_Handle = NULL;
                 return false;
             }
-            mstp_port->DataCRC = 0xFFFF;
-            for (i = 0; i < mstp_port->DataLength; i++) {
-                mstp_port->DataCRC = CRC_Calc_Data(
-                    mstp_port->InputBuffer[i], mstp_port->DataCRC);
-            }
+            mstp_port->DataCRC = CRC_Calc_Data_Buffer(
+                mstp_port->InputBuffer, mstp_port->DataLength, 0xFFFF);
             mstp_port->DataCRC =
                 CRC_Calc_Data(mstp_port->DataCRCActualMSB, mstp_port->DataCRC);
             mstp_port->DataCRC =
@@ -18,7 +18,9 @@
 #include "bacnet/bacdef.h"
 /* BACnet Stack API */
 #include "bacnet/basic/sys/mstimer.h"
+#include "bacnet/datalink/cobs.h"
 #include "bacnet/datalink/crc.h"
+#include "bacnet/datalink/mstpdef.h"
 #include "bacnet/version.h"
 /* OS specific include*/
 #include "bacport.h"
@@ -32,6 +34,7 @@ static unsigned CRC_Size = 8;
 /* save to capture file for viewing in Wireshark */
 static bool MSTP_Cap = false;
 static bool MSTP_Text_File = false;
+static bool CRC_Benchmark = false;
 static char Capture_Filename[64] = "mstp_20090123091200.cap";
 static FILE *pFile = NULL; /* stream pointer */
 static FILE *pText_File = NULL; /* stream pointer */
@@ -107,6 +110,10 @@ static void Parse_Arguments(int argc, char *argv[])
                 case 'F':
                     MSTP_Text_File = true;
                     break;
+                case 'b':
+                case 'B':
+                    CRC_Benchmark = true;
+                    break;
                 default:
                     break;
             }
@@ -231,12 +238,83 @@ static void Process_Text_File(void)
     }
 }
 
+/******************************************************************
+ * DESCRIPTION:  Compares the throughput of the octet-at-a-time CRC
+ *               functions with the buffer CRC functions for the
+ *               selected CRC size, using a maximum size buffer.
+ * RETURN:       nothing
+ * NOTES:        none
+ ******************************************************************/
+static void CRC_Benchmark_Run(void)
+{
+    static uint8_t buffer[sizeof(CRC_Buffer)];
+    const unsigned passes = 20000;
+    unsigned long octets = 0;
+    unsigned long elapsed[2] = { 0 };
+    unsigned long start;
+    uint32_t crc[2] = { 0 };
+    unsigned pass, i, j;
+
+    for (i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t)((i * 167) + 13);
+    }
+    for (j = 0; j < 2; j++) {
+        start = mstimer_now();
+        for (pass = 0; pass < passes; pass++) {
+            if (CRC_Size == 8) {
+                if (j == 0) {
+                    for (i = 0; i < sizeof(buffer); i++) {
+                        crc[j] = CRC_Calc_Header(buffer[i], crc[j]);
+                    }
+                } else {
+                    crc[j] = CRC_Calc_Header_Buffer(
+                        buffer, sizeof(buffer), crc[j]);
+                }
+            } else if (CRC_Size == 16) {
+                if (j == 0) {
+                    for (i = 0; i < sizeof(buffer); i++) {
+                        crc[j] = CRC_Calc_Data(buffer[i], crc[j]);
+                    }
+                } else {
+                    crc[j] =
+                        CRC_Calc_Data_Buffer(buffer, sizeof(buffer), crc[j]);
+                }
+            } else {
+                if (j == 0) {
+                    for (i = 0; i < sizeof(buffer); i++) {
+                        crc[j] = cobs_crc32k(buffer[i], crc[j]);
+                    }
+                } else {
+                    crc[j] =
+                        cobs_crc32k_buffer(buffer, sizeof(buffer), crc[j]);
+                }
+            }
+        }
+        elapsed[j] = mstimer_now() - start;
+        if (elapsed[j] == 0) {
+            elapsed[j] = 1;
+        }
+    }
+    octets = (unsigned long)passes * sizeof(buffer);
+    printf("CRC-%u over %lu octets\r\n", CRC_Size, octets);
+    printf(
+        "octet:  %lu ms, %lu octets/ms\r\n", elapsed[0], octets / elapsed[0]);
+    printf(
+        "buffer: %lu ms, %lu octets/ms\r\n", elapsed[1], octets / elapsed[1]);
+    if (crc[0] != crc[1]) {
+        printf(
+            "CRC mismatch: 0x%08lX 0x%08lX\r\n", (unsigned long)crc[0],
+            (unsigned long)crc[1]);
+    }
+}
+
 /* simple program to CRC the data and print the CRC */
 int main(int argc, char *argv[])
 {
     /* accumulates the crc value */
     uint8_t crc8 = 0xff;
     uint16_t crc16 = 0xffff;
+    uint32_t crc32 = CRC32K_INITIAL_VALUE;
     unsigned i = 0;
 
     /* initialize our interface */
@@ -252,6 +330,7 @@ int main(int argc, char *argv[])
             "[-16] calculate the MS/TP 16-bit Data CRC\r\n"
             "[-32] calculate the MS/TP 32-bit Extended Frame CRC\r\n"
             "[-f filename] read MS/TP capture data from text file\r\n"
+            "[-b] benchmark the octet and buffer CRC functions\r\n"
             "Note: MS/TP Header CRC does not include the 55 FF preamble.\r\n");
         return 0;
     }
@@ -265,18 +344,23 @@ int main(int argc, char *argv[])
         return 0;
     }
     Parse_Arguments(argc, argv);
-    if (MSTP_Text_File) {
+    if (CRC_Benchmark) {
+        mstimer_init();
+        CRC_Benchmark_Run();
+    } else if (MSTP_Text_File) {
         Process_Text_File();
     } else if (CRC_Buffer_Len) {
         if (MSTP_Cap) {
             Write_Pcap(CRC_Buffer, CRC_Buffer_Len);
         } else {
+            if (CRC_Size == 8) {
+                crc8 = CRC_Calc_Header_Buffer(CRC_Buffer, CRC_Buffer_Len, crc8);
+            } else if (CRC_Size == 16) {
+                crc16 = CRC_Calc_Data_Buffer(CRC_Buffer, CRC_Buffer_Len, crc16);
+            } else if (CRC_Size == 32) {
+                crc32 = cobs_crc32k_buffer(CRC_Buffer, CRC_Buffer_Len, crc32);
+            }
             for (i = 0; i < CRC_Buffer_Len; i++) {
-                if (CRC_Size == 8) {
-                    crc8 = CRC_Calc_Header(CRC_Buffer[i], crc8);
-                } else if (CRC_Size == 16) {
-                    crc16 = CRC_Calc_Data(CRC_Buffer[i], crc16);
-                }
                 if (ASCII_Decimal) {
                     printf("%u\r\n", (unsigned)CRC_Buffer[i]);
                 } else {
@@ -299,6 +383,20 @@ int main(int argc, char *argv[])
                     printf("0x%02X Data CRC\r\n", (crc16 & 0xFF));
                     printf("0x%02X Data CRC\r\n", (crc16 >> 8));
                 }
+            } else if (CRC_Size == 32) {
+                /* the CRC-32K is sent LSB first, before COBS encoding */
+                crc32 = ~crc32;
+                for (i = 0; i < 4; i++) {
+                    if (ASCII_Decimal) {
+                        printf(
+                            "%u Extended CRC\r\n",
+                            (unsigned)((crc32 >> (i * 8)) & 0xFF));
+                    } else {
+                        printf(
+                            "0x%02X Extended CRC\r\n",
+                            (unsigned)((crc32 >> (i * 8)) & 0xFF));
+                    }
+                }
             }
         }
     }
@@ -28,8 +28,12 @@
 #include "bacnet/basic/tsm/tsm.h"
 #include "bacnet/basic/binding/address.h"
 #include "bacnet/basic/services.h"
+#include "bacnet/basic/npdu/router_table.h"
 /* port agnostic file */
 #include "bacport.h"
+#if defined(__linux__)
+#include "router-loop.h"
+#endif
 /* our datalink layers */
 #include "bacnet/datalink/dlmstp.h"
 #include "bacnet/datalink/bip.h"
@@ -59,16 +63,8 @@ static const char *BACnet_Version = BACNET_VERSION_TEXT;
  * unreachability due to the imposition of a congestion control
  * restriction.
  */
-typedef struct _dnet {
-    uint8_t mac[MAX_MAC_LEN];
-    uint8_t mac_len;
-    uint16_t net;
-    bool enabled;
-    struct _dnet *dnets;
-    struct _dnet *next;
-} DNET;
-/* The list of DNETs that our router can reach. */
-static DNET *Router_Table_Head;
+/* The table of ports and of the DNETs that our router can reach. */
+static BACNET_ROUTER_TABLE Router_Table;
 /* track our directly connected ports network number */
 static uint16_t BIP_Net;
 static uint16_t MSTP_Net;
@@ -92,60 +88,25 @@ static bool Exit_Requested;
  * The caller will need to compare the sought after net with the
  * returned port->net to determine if the addr is filled.
  */
-static DNET *dnet_find(uint16_t net, BACNET_ADDRESS *addr)
+static BACNET_ROUTER_TABLE_PORT *dnet_find(uint16_t net, BACNET_ADDRESS *addr)
 {
-    DNET *port = Router_Table_Head;
-    DNET *dnet = NULL;
-    unsigned int i = 0;
-
-    while (port != NULL) {
-        if (net == port->net) {
-            /* DNET is directly connected to the router */
-            return port;
-        } else if (port->dnets) {
-            /* search router ports DNET list */
-            dnet = port->dnets;
-            while (dnet != NULL) {
-                if (net == dnet->net) {
-                    if (addr) {
-                        addr->mac_len = dnet->mac_len;
-                        for (i = 0; i < MAX_MAC_LEN; i++) {
-                            addr->mac[i] = dnet->mac[i];
-                        }
-                    }
-                    return port;
-                }
-                dnet = dnet->next;
-            }
-        }
-        port = port->next;
-    }
-
-    return NULL;
+    return bacnet_router_table_route(&Router_Table, net, addr);
 }
 
 static bool port_find(uint16_t snet, BACNET_ADDRESS *addr)
 {
-    DNET *port = NULL;
-    bool found = false;
+    const BACNET_ROUTER_TABLE_PORT *port = NULL;
     unsigned int i = 0;
 
-    port = Router_Table_Head;
-    while (port) {
-        if (port->net == snet) {
-            if (addr) {
-                addr->mac_len = port->mac_len;
-                for (i = 0; i < MAX_MAC_LEN; i++) {
-                    addr->mac[i] = port->mac[i];
-                }
-            }
-            found = true;
-            break;
+    port = bacnet_router_table_port_find(&Router_Table, snet);
+    if (port && addr) {
+        addr->mac_len = port->mac_len;
+        for (i = 0; i < MAX_MAC_LEN; i++) {
+            addr->mac[i] = port->mac[i];
         }
-        port = port->next;
     }
 
-    return found;
+    return port != NULL;
 }
 
 /**
@@ -156,42 +117,9 @@ static bool port_find(uint16_t snet, BACNET_ADDRESS *addr)
  */
 static void port_add(uint16_t snet, const BACNET_ADDRESS *addr)
 {
-    DNET *port = NULL;
-    DNET *dnet = NULL;
-    unsigned int i = 0;
-
-    port = dnet_find(snet, NULL);
-    if (!port) {
-        port = Router_Table_Head;
-        if (!port) {
-            /* create first port */
-            port = (DNET *)calloc(1, sizeof(DNET));
-            assert(port);
-            Router_Table_Head = port;
-        } else {
-            while (port) {
-                if (port->next) {
-                    port = port->next;
-                } else {
-                    /* create next port */
-                    dnet = (DNET *)calloc(1, sizeof(DNET));
-                    assert(dnet);
-                    port->next = dnet;
-                    port = port->next;
-                    break;
-                }
-            }
-        }
-        port->net = snet;
-        if (addr) {
-            port->mac_len = addr->mac_len;
-            for (i = 0; i < MAX_MAC_LEN; i++) {
-                port->mac[i] = addr->mac[i];
-            }
-        } else {
-            port->mac_len = 0;
-        }
-        port->enabled = true;
+    if (bacnet_router_table_port_add(&Router_Table, snet, addr, NULL) < 0) {
+        debug_log_fprintf(
+            DEBUG_LOG_ERROR, stderr, "Port %u not added\n", (unsigned)snet);
     }
 }
 
@@ -204,74 +132,43 @@ static void port_add(uint16_t snet, const BACNET_ADDRESS *addr)
  */
 static void dnet_add(uint16_t snet, uint16_t net, const BACNET_ADDRESS *addr)
 {
-    DNET *dnet = NULL;
-    DNET *port = NULL;
-    DNET *prior_dnet = NULL;
-    unsigned int i = 0;
-
-    /* make sure NETs are not repeated */
-    dnet = dnet_find(net, NULL);
-    if (dnet) {
-        return;
-    }
-    /* start with the source network number table */
-    port = dnet_find(snet, NULL);
-    if (!port) {
-        return;
-    }
-    dnet = port->dnets;
-    if (dnet == NULL) {
-        /* first DNET to add */
-        dnet = (DNET *)calloc(1, sizeof(DNET));
-        assert(dnet);
-        port->dnets = dnet;
-        if (addr) {
-            dnet->mac_len = addr->mac_len;
-            for (i = 0; i < MAX_MAC_LEN; i++) {
-                dnet->mac[i] = addr->mac[i];
-            }
-        }
-        dnet->net = net;
-        dnet->enabled = true;
-        dnet->next = NULL;
-    } else {
-        while (dnet != NULL) {
-            if (dnet->net == net) {
-                /* make sure NETs are not repeated */
-                return;
-            }
-            prior_dnet = dnet;
-            dnet = dnet->next;
-        }
-        /* next DNET to add */
-        dnet = (DNET *)calloc(1, sizeof(DNET));
-        if (addr) {
-            dnet->mac_len = addr->mac_len;
-            for (i = 0; i < MAX_MAC_LEN; i++) {
-                dnet->mac[i] = addr->mac[i];
-            }
-        }
-        dnet->net = net;
-        dnet->enabled = true;
-        dnet->next = NULL;
-        prior_dnet->next = dnet;
-    }
+    bacnet_router_table_dnet_add(&Router_Table, snet, net, addr);
 }
 
 /**
- * Free the DNET data of a route
+ * Set the reachability status of a list of DNETs, or of all the
+ * DNETs reachable through a port when the list is empty.
  *
- * @param dnets - router info to be freed
+ * @param snet - router port SNET where the message was received
+ * @param npdu - list of 2-octet network numbers
+ * @param npdu_len - number of octets in the list
+ * @param status - reachability status to set
  */
-static void dnet_cleanup(DNET *dnets)
+static void dnet_status_set(
+    uint16_t snet,
+    const uint8_t *npdu,
+    uint16_t npdu_len,
+    BACNET_ROUTER_TABLE_STATUS status)
 {
-    DNET *dnet = dnets;
-    while (dnet != NULL) {
-        debug_log_fprintf(
-            DEBUG_LOG_DEBUG, stderr, "DNET %u removed\n", (unsigned)dnet->net);
-        dnet = dnet->next;
-        free(dnets);
-        dnets = dnet;
+    BACNET_ROUTER_TABLE_ENTRY *entry = NULL;
+    unsigned cursor = 0;
+    uint16_t len = 0;
+    uint16_t net = 0;
+    int port_index = 0;
+
+    if (npdu_len >= 2) {
+        while ((len + 2) <= npdu_len) {
+            len += decode_unsigned16(&npdu[len], &net);
+            bacnet_router_table_status_set(&Router_Table, net, status);
+        }
+    } else {
+        port_index = bacnet_router_table_port_index(&Router_Table, snet);
+        while ((entry = bacnet_router_table_dnet_next(
+                    &Router_Table, &cursor)) != NULL) {
+            if ((entry->port_index == port_index) && (entry->net != snet)) {
+                entry->status = (uint8_t)status;
+            }
+        }
     }
 }
 
@@ -311,6 +208,12 @@ static int datalink_send_pdu(
 {
     int bytes_sent = 0;
 
+#if defined(__linux__)
+    debug_log_fprintf(
+        DEBUG_LOG_DEBUG, stderr, "Send via NET %u to DNET %u\n",
+        (unsigned)snet, (unsigned)dest->net);
+    bytes_sent = router_loop_send_pdu(snet, dest, npdu_data, pdu, pdu_len);
+#else
     if (snet == 0) {
         debug_log_fprintf(
             DEBUG_LOG_DEBUG, stderr, "BVLC & MS/TP Send to DNET %u\n",
@@ -328,6 +231,7 @@ static int datalink_send_pdu(
             (unsigned)dest->net);
         bytes_sent = dlmstp_send_pdu(dest, npdu_data, pdu, pdu_len);
     }
+#endif
 
     return bytes_sent;
 }
@@ -349,9 +253,9 @@ static void send_i_am_router_to_network(uint16_t snet, uint16_t net)
     BACNET_NPDU_DATA npdu_data;
     int pdu_len = 0;
     int len = 0;
-    DNET *port = NULL;
-    DNET *dnet = NULL;
-    bool buffer_full = false;
+    BACNET_ROUTER_TABLE_ENTRY *entry = NULL;
+    unsigned cursor = 0;
+    int port_index = 0;
 
     datalink_get_broadcast_address(&dest);
     npdu_encode_npdu_network(
@@ -372,39 +276,23 @@ static void send_i_am_router_to_network(uint16_t snet, uint16_t net)
             This enables routers to build or update their routing table
             entries for each of the network numbers contained in the message.
         */
-        port = Router_Table_Head;
-        while (port != NULL) {
-            if (port->net != snet) {
-                if ((pdu_len + 2) > (int)sizeof(Tx_Buffer)) {
-                    debug_log_fprintf(
-                        DEBUG_LOG_WARNING, stderr,
-                        "I-Am-Router-To-Network truncated - "
-                        "Tx_Buffer full\n");
-                    break;
-                }
-                debug_log_fprintf(DEBUG_LOG_INFO, stderr, "%u,", port->net);
-                len = encode_unsigned16(&Tx_Buffer[pdu_len], port->net);
-                pdu_len += len;
-                dnet = port->dnets;
-                while (dnet != NULL) {
-                    if ((pdu_len + 2) > (int)sizeof(Tx_Buffer)) {
-                        debug_log_fprintf(
-                            DEBUG_LOG_WARNING, stderr,
-                            "I-Am-Router-To-Network truncated - "
-                            "Tx_Buffer full\n");
-                        buffer_full = true;
-                        break;
-                    }
-                    debug_log_fprintf(DEBUG_LOG_INFO, stderr, "%u,", dnet->net);
-                    len = encode_unsigned16(&Tx_Buffer[pdu_len], dnet->net);
-                    pdu_len += len;
-                    dnet = dnet->next;
-                }
-                if (buffer_full) {
-                    break;
-                }
+        port_index = bacnet_router_table_port_index(&Router_Table, snet);
+        while ((entry = bacnet_router_table_dnet_next(
+                    &Router_Table, &cursor)) != NULL) {
+            if ((entry->port_index == port_index) ||
+                (entry->status == BACNET_ROUTER_TABLE_UNREACHABLE)) {
+                continue;
+            }
+            if ((pdu_len + 2) > (int)sizeof(Tx_Buffer)) {
+                debug_log_fprintf(
+                    DEBUG_LOG_WARNING, stderr,
+                    "I-Am-Router-To-Network truncated - "
+                    "Tx_Buffer full\n");
+                break;
             }
-            port = port->next;
+            debug_log_fprintf(DEBUG_LOG_INFO, stderr, "%u,", entry->net);
+            len = encode_unsigned16(&Tx_Buffer[pdu_len], entry->net);
+            pdu_len += len;
         }
         debug_log_fprintf(DEBUG_LOG_INFO, stderr, "from %u\n", snet);
     }
@@ -434,7 +322,8 @@ send_initialize_routing_table_ack(uint8_t snet, const BACNET_ADDRESS *dst)
     int len = 0;
     uint8_t count = 0;
     uint8_t port_id = 1;
-    DNET *port = NULL;
+    unsigned i = 0;
+    const BACNET_ROUTER_TABLE_PORT *port = NULL;
 
     if (dst) {
         bacnet_address_copy(&dest, dst);
@@ -448,29 +337,22 @@ send_initialize_routing_table_ack(uint8_t snet, const BACNET_ADDRESS *dst)
        our downstream BACnet network. */
     pdu_len = npdu_encode_pdu(&Tx_Buffer[0], &dest, NULL, &npdu_data);
     /* First, count the number of Ports we will encode */
-    port = Router_Table_Head;
-    while (port != NULL) {
-        count++;
-        port = port->next;
-    }
+    count = (uint8_t)bacnet_router_table_port_count(&Router_Table);
     Tx_Buffer[pdu_len] = count;
     pdu_len++;
-    if (count > 0) {
-        /* Now encode each BACNET_ROUTER_PORT.
-         * We will simply use a positive index for PortID,
-         * and have no PortInfo.
-         */
-        port = Router_Table_Head;
-        while (port != NULL) {
-            len = encode_unsigned16(&Tx_Buffer[pdu_len], port->net);
-            pdu_len += len;
-            Tx_Buffer[pdu_len] = port_id;
-            pdu_len++;
-            port_id++;
-            Tx_Buffer[pdu_len] = 0;
-            pdu_len++;
-            port = port->next;
-        }
+    /* Now encode each BACNET_ROUTER_PORT.
+     * We will simply use a positive index for PortID,
+     * and have no PortInfo.
+     */
+    for (i = 0; i < count; i++) {
+        port = bacnet_router_table_port(&Router_Table, i);
+        len = encode_unsigned16(&Tx_Buffer[pdu_len], port->net);
+        pdu_len += len;
+        Tx_Buffer[pdu_len] = port_id;
+        pdu_len++;
+        port_id++;
+        Tx_Buffer[pdu_len] = 0;
+        pdu_len++;
     }
     /* Now send the message */
     datalink_send_pdu(snet, &dest, &npdu_data, &Tx_Buffer[0], pdu_len);
@@ -608,7 +490,10 @@ static void who_is_router_to_network_handler(
     const uint8_t *npdu,
     uint16_t npdu_len)
 {
-    DNET *port = NULL;
+    const BACNET_ROUTER_TABLE_PORT *port = NULL;
+    const uint8_t *list = NULL;
+    unsigned count = 0;
+    unsigned i = 0;
     uint16_t network = 0;
     uint16_t len = 0;
 
@@ -626,12 +511,11 @@ static void who_is_router_to_network_handler(
                 }
             } else {
                 /* discover the next router on the path to the network */
-                port = Router_Table_Head;
-                while (port) {
-                    if (port->net != snet) {
-                        send_who_is_router_to_network(port->net, network);
-                    }
-                    port = port->next;
+                list = bacnet_router_table_broadcast_ports(
+                    &Router_Table, snet, &count);
+                for (i = 0; i < count; i++) {
+                    port = bacnet_router_table_port(&Router_Table, list[i]);
+                    send_who_is_router_to_network(port->net, network);
                 }
             }
         } else {
@@ -729,8 +613,12 @@ static void network_control_handler(
             }
             break;
         case NETWORK_MESSAGE_ROUTER_BUSY_TO_NETWORK:
+            /* temporarily unreachable due to congestion control */
+            dnet_status_set(snet, npdu, npdu_len, BACNET_ROUTER_TABLE_BUSY);
+            break;
         case NETWORK_MESSAGE_ROUTER_AVAILABLE_TO_NETWORK:
-            /* Do nothing - don't support upstream traffic congestion control */
+            dnet_status_set(
+                snet, npdu, npdu_len, BACNET_ROUTER_TABLE_REACHABLE);
             break;
         case NETWORK_MESSAGE_INIT_RT_TABLE:
             /* If sent with Number of Ports == 0, we respond with
@@ -860,7 +748,11 @@ static void routed_apdu_handler(
     uint8_t *apdu,
     uint16_t apdu_len)
 {
-    DNET *port = NULL;
+    const BACNET_ROUTER_TABLE_PORT *port = NULL;
+    BACNET_ROUTER_TABLE_STATUS status;
+    const uint8_t *list = NULL;
+    unsigned count = 0;
+    unsigned i = 0;
     BACNET_ADDRESS local_dest;
     BACNET_ADDRESS remote_dest;
     BACNET_ADDRESS router_src;
@@ -891,13 +783,12 @@ static void routed_apdu_handler(
             debug_log_fprintf(
                 DEBUG_LOG_DEBUG, stderr, "Routing a BROADCAST from %u\n",
                 (unsigned)snet);
-            port = Router_Table_Head;
-            while (port != NULL) {
-                if (port->net != snet) {
-                    datalink_send_pdu(
-                        port->net, &local_dest, npdu, &Tx_Buffer[0], pdu_len);
-                }
-                port = port->next;
+            list =
+                bacnet_router_table_broadcast_ports(&Router_Table, snet, &count);
+            for (i = 0; i < count; i++) {
+                port = bacnet_router_table_port(&Router_Table, list[i]);
+                datalink_send_pdu(
+                    port->net, &local_dest, npdu, &Tx_Buffer[0], pdu_len);
             }
         }
         return;
@@ -905,6 +796,20 @@ static void routed_apdu_handler(
     remote_dest = *dest;
     port = dnet_find(dest->net, &remote_dest);
     if (port) {
+        status = bacnet_router_table_status(&Router_Table, dest->net);
+        if (status != BACNET_ROUTER_TABLE_REACHABLE) {
+            /* congestion control or a failed route to the network */
+            debug_log_fprintf(
+                DEBUG_LOG_DEBUG, stderr, "Route to %u is not available\n",
+                (unsigned)dest->net);
+            send_reject_message_to_network(
+                snet, src,
+                (status == BACNET_ROUTER_TABLE_BUSY)
+                    ? NETWORK_REJECT_ROUTER_BUSY
+                    : NETWORK_REJECT_NO_ROUTE,
+                dest->net);
+            return;
+        }
         if (port->net == dest->net) {
             debug_log_fprintf(
                 DEBUG_LOG_DEBUG, stderr, "Routing to Port %u\n",
@@ -960,13 +865,11 @@ static void routed_apdu_handler(
             &Tx_Buffer[0], dest, &router_src, npdu, apdu, apdu_len);
         if (pdu_len > 0) {
             /* send to all other ports */
-            port = Router_Table_Head;
-            while (port != NULL) {
-                if (port->net != snet) {
-                    datalink_send_pdu(
-                        port->net, dest, npdu, &Tx_Buffer[0], pdu_len);
-                }
-                port = port->next;
+            list =
+                bacnet_router_table_broadcast_ports(&Router_Table, snet, &count);
+            for (i = 0; i < count; i++) {
+                port = bacnet_router_table_port(&Router_Table, list[i]);
+                datalink_send_pdu(port->net, dest, npdu, &Tx_Buffer[0], pdu_len);
             }
         }
         /*  If the next router is unknown, an attempt shall be made to
@@ -1154,23 +1057,61 @@ static void datalink_init(void)
     port_add(MSTP_Net, &my_address);
 }
 
+/**
+ * Handle the datalink timers
+ *
+ * @param elapsed_seconds - number of seconds since the last call
+ */
+static void datalink_maintenance_timer(uint32_t elapsed_seconds)
+{
+    bvlc_maintenance_timer(elapsed_seconds);
+}
+
+#if defined(__linux__)
+/**
+ * Add the BACnet/IP and BACnet MS/TP ports to the epoll event loop.
+ * The number of worker threads the ports are sharded across is
+ * configured with BACNET_ROUTER_WORKERS, and defaults to 1.
+ */
+static void router_loop_setup(void)
+{
+    char *pEnv = NULL;
+    unsigned workers = 1;
+
+    pEnv = getenv("BACNET_ROUTER_WORKERS");
+    if (pEnv) {
+        workers = (unsigned)strtoul(pEnv, NULL, 0);
+    }
+    if (!router_loop_init(
+            workers, my_routing_npdu_handler, datalink_maintenance_timer)) {
+        fprintf(stderr, "Failed to initialize the router event loop!\n");
+        exit(1);
+    }
+    if ((router_loop_port_add(
+             BIP_Net, bip_get_socket(), bip_get_broadcast_socket(),
+             bip_receive, bip_send_pdu, &BIP_Rx_Buffer[0],
+             sizeof(BIP_Rx_Buffer)) < 0) ||
+        (router_loop_port_add(
+             MSTP_Net, dlmstp_receive_fd(), -1, dlmstp_receive,
+             dlmstp_send_pdu, &MSTP_Rx_Buffer[0],
+             sizeof(MSTP_Rx_Buffer)) < 0)) {
+        fprintf(stderr, "Failed to add the router event loop ports!\n");
+        exit(1);
+    }
+}
+#endif
+
 /**
  * Cleanup memory
  *
  */
 static void cleanup(void)
 {
-    DNET *port = NULL;
-
     debug_log_fprintf(DEBUG_LOG_INFO, stderr, "Cleaning up...\n");
-    /* clean up the remote networks */
-    port = Router_Table_Head;
-    while (port != NULL) {
-        dnet_cleanup(port->dnets);
-        port = port->next;
-    }
-    /* clean up the directly connected networks */
-    dnet_cleanup(Router_Table_Head);
+#if defined(__linux__)
+    router_loop_cleanup();
+#endif
+    bacnet_router_table_cleanup(&Router_Table);
 }
 
 #if defined(_WIN32)
@@ -1198,7 +1139,12 @@ static void sig_int(int signo)
 {
     (void)signo;
     Exit_Requested = true;
+#if defined(__linux__)
+    /* the event loop returns to main() */
+    router_loop_stop();
+#else
     exit(0);
+#endif
 }
 
 static void signal_init(void)
@@ -1224,26 +1170,35 @@ static void control_c_hooks(void)
  */
 int main(int argc, char *argv[])
 {
+#if !defined(__linux__)
     BACNET_ADDRESS src = { 0 }; /* address where message came from */
     uint16_t pdu_len = 0;
     time_t last_seconds = 0;
     time_t current_seconds = 0;
     uint32_t elapsed_seconds = 0;
+#endif
 
     (void)argc;
     (void)argv;
     printf("BACnet Simple MS/TP to IP Router Demo\n");
     printf("BACnet Stack Version %s\n", BACnet_Version);
     datalink_init();
+#if defined(__linux__)
+    router_loop_setup();
+#endif
     atexit(cleanup);
     control_c_hooks();
-    /* configure the timeout values */
-    last_seconds = time(NULL);
     /* broadcast an I-Am on startup */
     printf("BACnet/IP Network: %u\n", (unsigned)BIP_Net);
     send_i_am_router_to_network(BIP_Net, 0);
     printf("BACnet MS/TP Network: %u\n", (unsigned)MSTP_Net);
     send_i_am_router_to_network(MSTP_Net, 0);
+#if defined(__linux__)
+    /* wait for and route packets until a signal stops the loop */
+    router_loop_run();
+#else
+    /* configure the timeout values */
+    last_seconds = time(NULL);
     /* loop forever */
     for (;;) {
         /* input */
@@ -1271,12 +1226,13 @@ int main(int argc, char *argv[])
         elapsed_seconds = (uint32_t)(current_seconds - last_seconds);
         if (elapsed_seconds) {
             last_seconds = current_seconds;
-            bvlc_maintenance_timer(elapsed_seconds);
+            datalink_maintenance_timer(elapsed_seconds);
         }
         if (Exit_Requested) {
             break;
         }
     }
+#endif
     /* tell signal interrupts we are done */
     Exit_Requested = false;
 
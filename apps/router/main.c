@@ -33,6 +33,9 @@
 #include "network_layer.h"
 #include "ipmodule.h"
 #include "mstpmodule.h"
+#if defined(BACNET_MSTP_TRUNKS)
+#include "mstp-trunks.h"
+#endif
 
 #define KEY_ESC 27
 
@@ -671,6 +674,11 @@ bool init_router(void)
         port = port->next;
     }
 
+#if defined(BACNET_MSTP_TRUNKS)
+    if (!mstp_trunks_init(MSTP_TRUNKS_WORKERS)) {
+        return false;
+    }
+#endif
     init_port_threads(head);
 
     /* wait for port initialization */
@@ -689,6 +697,17 @@ bool init_router(void)
         }
     }
 
+    /* add the initialized ports to the routing table */
+    bacnet_router_table_init(&Router_Table);
+    port = head;
+    while (port != NULL) {
+        if (!add_port(port)) {
+            PRINT(ERROR, "Error: Failed to route %s\n", port->iface);
+            return false;
+        }
+        port = port->next;
+    }
+
     return true;
 }
 
@@ -719,13 +738,16 @@ void cleanup(void)
     port = head;
     while (port != NULL) {
         if (port->state == FINISHED) {
-            cleanup_dnets(port->route_info.dnets);
             port = port->next;
             free(head->iface);
             free(head);
             head = port;
         }
     }
+    cleanup_dnets();
+#if defined(BACNET_MSTP_TRUNKS)
+    mstp_trunks_cleanup();
+#endif
 
     pthread_mutex_destroy(&msg_lock);
 }
@@ -15,6 +15,9 @@
 #include "mstpmodule.h"
 #include "bacnet/bacint.h"
 #include "dlmstp_port.h"
+#if defined(BACNET_MSTP_TRUNKS)
+#include "mstp-trunks.h"
+#endif
 
 void *dl_mstp_thread(void *pArgs)
 {
@@ -23,6 +26,9 @@ void *dl_mstp_thread(void *pArgs)
     SHARED_MSTP_DATA shared_port_data = { 0 };
     uint16_t pdu_len;
     uint8_t shutdown = 0;
+#if defined(BACNET_MSTP_TRUNKS)
+    int trunk;
+#endif
 
     shared_port_data.MSTP_Packets = 0;
     shared_port_data.RS485_Handle = -1;
@@ -63,11 +69,26 @@ void *dl_mstp_thread(void *pArgs)
     dlmstp_set_mac_address(&mstp_port, port->route_info.mac[0]);
     dlmstp_set_max_info_frames(&mstp_port, port->params.mstp_params.max_frames);
     dlmstp_set_max_master(&mstp_port, port->params.mstp_params.max_master);
+#if defined(BACNET_MSTP_TRUNKS)
+    if (!dlmstp_port_open(&mstp_port, port->iface)) {
+        printf("MSTP %s init failed. Stop.\n", port->iface);
+    }
+    mstp_port.Treply_timeout = 260;
+    mstp_port.Tusage_timeout = 30;
+    trunk = mstp_trunks_add(&mstp_port);
+    if (trunk < 0) {
+        printf("MSTP %s could not be serviced. Stop.\n", port->iface);
+        dlmstp_cleanup(&mstp_port);
+        port->state = INIT_FAILED;
+        return NULL;
+    }
+#else
     if (!dlmstp_init(&mstp_port, port->iface)) {
         printf("MSTP %s init failed. Stop.\n", port->iface);
     }
     mstp_port.Treply_timeout = 260;
     mstp_port.Tusage_timeout = 30;
+#endif
 
     port->port_id = create_msgbox();
     if (port->port_id == INVALID_MSGBOX_ID) {
@@ -146,6 +167,9 @@ void *dl_mstp_thread(void *pArgs)
         }
     }
 
+#if defined(BACNET_MSTP_TRUNKS)
+    (void)mstp_trunks_remove(trunk);
+#endif
     dlmstp_cleanup(&mstp_port);
     port->state = FINISHED;
 
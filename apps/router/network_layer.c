@@ -195,6 +195,7 @@ uint16_t create_network_message(
     void *val)
 {
     int16_t buff_len;
+    int buff_size = 128;
     bool data_expecting_reply = false;
     BACNET_NPDU_DATA npdu_data;
 
@@ -203,7 +204,12 @@ uint16_t create_network_message(
     }
     init_npdu(&npdu_data, network_message_type, data_expecting_reply);
 
-    *buff = (uint8_t *)malloc(128); /* resolve different length */
+    if ((network_message_type == NETWORK_MESSAGE_I_AM_ROUTER_TO_NETWORK) &&
+        (val == NULL)) {
+        /* room for every network in the routing table */
+        buff_size += 2 * (int)bacnet_router_table_dnet_count(&Router_Table);
+    }
+    *buff = (uint8_t *)malloc(buff_size); /* resolve different length */
 
     /* manual destination setup for Init-RT-Table-Ack message */
     data->dest.net = BACNET_BROADCAST_NETWORK;
@@ -224,28 +230,22 @@ uint16_t create_network_message(
                 uint16_t val16 = (valptr[0]) + (valptr[1] << 8);
                 buff_len += encode_unsigned16(*buff + buff_len, val16);
             } else {
-                ROUTER_PORT *port = head;
-                DNET *dnet;
-                while (port != NULL) {
-                    if (port->route_info.net != data->src.net) {
-                        buff_len += encode_unsigned16(
-                            *buff + buff_len, port->route_info.net);
-                        dnet = port->route_info.dnets;
-                        while (dnet != NULL) {
-                            buff_len +=
-                                encode_unsigned16(*buff + buff_len, dnet->net);
-                            dnet = dnet->next;
-                        }
-                        port = port->next;
-                    } else {
-                        dnet = port->route_info.dnets;
-                        while (dnet != NULL) {
-                            buff_len +=
-                                encode_unsigned16(*buff + buff_len, dnet->net);
-                            dnet = dnet->next;
-                        }
-                        port = port->next;
+                /* list each network except the networks reachable
+                   via the network on which the broadcast is being made */
+                const BACNET_ROUTER_TABLE_ENTRY *dnet;
+                unsigned cursor = 0;
+                int port_index =
+                    bacnet_router_table_port_index(&Router_Table, data->src.net);
+                while ((dnet = bacnet_router_table_dnet_next(
+                            &Router_Table, &cursor)) != NULL) {
+                    if (dnet->port_index == port_index) {
+                        continue;
+                    }
+                    if ((buff_len + 2) > buff_size) {
+                        PRINT(ERROR, "I-Am-Router-To-Network truncated\n");
+                        break;
                     }
+                    buff_len += encode_unsigned16(*buff + buff_len, dnet->net);
                 }
             }
             break;
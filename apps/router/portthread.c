@@ -13,6 +13,8 @@
 #include <string.h>
 #include "portthread.h"
 
+BACNET_ROUTER_TABLE Router_Table;
+
 ROUTER_PORT *find_snet(MSGBOX_ID id)
 {
     ROUTER_PORT *port = head;
@@ -29,76 +31,55 @@ ROUTER_PORT *find_snet(MSGBOX_ID id)
 
 ROUTER_PORT *find_dnet(uint16_t net, BACNET_ADDRESS *addr)
 {
-    ROUTER_PORT *port = head;
-    DNET *dnet;
+    const BACNET_ROUTER_TABLE_ENTRY *dnet;
+    const BACNET_ROUTER_TABLE_PORT *port;
 
     /* for broadcast messages no search is needed */
     if (net == BACNET_BROADCAST_NETWORK) {
-        return port;
+        return head;
     }
 
-    while (port != NULL) {
-        /* check if DNET is directly connected to the router */
-        if (net == port->route_info.net) {
-            return port;
-
-            /* else search router ports DNET list */
-        } else if (port->route_info.dnets) {
-            dnet = port->route_info.dnets;
-            while (dnet != NULL) {
-                if (net == dnet->net) {
-                    if (addr) {
-                        memmove(&addr->len, &dnet->mac_len, 1);
-                        memmove(&addr->adr[0], &dnet->mac[0], MAX_MAC_LEN);
-                    }
-                    return port;
-                }
-                dnet = dnet->next;
-            }
-        }
-        port = port->next;
+    dnet = bacnet_router_table_dnet_find(&Router_Table, net);
+    if (dnet == NULL) {
+        return NULL;
+    }
+    port = bacnet_router_table_port(&Router_Table, dnet->port_index);
+    if (port == NULL) {
+        return NULL;
+    }
+    /* if DNET is not directly connected to the router
+       use the address of the next router */
+    if (addr && (port->net != net)) {
+        memmove(&addr->len, &dnet->mac_len, 1);
+        memmove(&addr->adr[0], &dnet->mac[0], MAX_MAC_LEN);
     }
 
-    return NULL;
+    return (ROUTER_PORT *)port->context;
 }
 
-void add_dnet(RT_ENTRY *route_info, uint16_t net, BACNET_ADDRESS addr)
+bool add_port(ROUTER_PORT *port)
 {
-    DNET *dnet = route_info->dnets;
-    DNET *tmp;
+    BACNET_ADDRESS addr = { 0 };
 
-    if (dnet == NULL) {
-        route_info->dnets = (DNET *)malloc(sizeof(DNET));
-        memmove(&route_info->dnets->mac_len, &addr.len, 1);
-        memmove(&route_info->dnets->mac[0], &addr.adr[0], MAX_MAC_LEN);
-        route_info->dnets->net = net;
-        route_info->dnets->state = true;
-        route_info->dnets->next = NULL;
-    } else {
-        while (dnet != NULL) {
-            if (dnet->net == net) { /* make sure NETs are not repeated */
-                return;
-            }
-            tmp = dnet;
-            dnet = dnet->next;
-        }
+    addr.mac_len = port->route_info.mac_len;
+    memmove(&addr.mac[0], &port->route_info.mac[0], MAX_MAC_LEN);
 
-        dnet = (DNET *)malloc(sizeof(DNET));
-        memmove(&dnet->mac_len, &addr.len, 1);
-        memmove(&dnet->mac[0], &addr.adr[0], MAX_MAC_LEN);
-        dnet->net = net;
-        dnet->state = true;
-        dnet->next = NULL;
-        tmp->next = dnet;
-    }
+    return bacnet_router_table_port_add(
+               &Router_Table, port->route_info.net, &addr, port) >= 0;
+}
+
+void add_dnet(RT_ENTRY *route_info, uint16_t net, BACNET_ADDRESS addr)
+{
+    BACNET_ADDRESS next_router = { 0 };
+
+    /* the routing table keeps the next router address as a MAC */
+    memmove(&next_router.mac_len, &addr.len, 1);
+    memmove(&next_router.mac[0], &addr.adr[0], MAX_MAC_LEN);
+    bacnet_router_table_dnet_add(
+        &Router_Table, route_info->net, net, &next_router);
 }
 
-void cleanup_dnets(DNET *dnets)
+void cleanup_dnets(void)
 {
-    DNET *dnet = dnets;
-    while (dnet != NULL) {
-        dnet = dnet->next;
-        free(dnets);
-        dnets = dnet;
-    }
+    bacnet_router_table_cleanup(&Router_Table);
 }
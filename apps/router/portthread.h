@@ -18,6 +18,7 @@
 #include "bacnet/bacdef.h"
 /* BACnet Stack API */
 #include "bacnet/npdu.h"
+#include "bacnet/basic/npdu/router_table.h"
 /* router utils */
 #include "msgqueue.h"
 
@@ -58,21 +59,11 @@ typedef union _port_params {
     } mstp_params;
 } PORT_PARAMS;
 
-/* list node for reacheble networks */
-typedef struct _dnet {
-    uint8_t mac[MAX_MAC_LEN];
-    uint8_t mac_len;
-    uint16_t net;
-    bool state; /* enabled or disabled */
-    struct _dnet *next;
-} DNET;
-
 /* information for routing table */
 typedef struct _routing_table_entry {
     uint8_t mac[MAX_MAC_LEN];
     uint8_t mac_len;
     uint16_t net;
-    DNET *dnets;
 } RT_ENTRY;
 
 typedef struct _port {
@@ -89,6 +80,8 @@ typedef struct _port {
 
 extern ROUTER_PORT *head;
 extern int port_count;
+/* directly connected ports and reachable networks */
+extern BACNET_ROUTER_TABLE Router_Table;
 
 /* get recieving router port */
 ROUTER_PORT *find_snet(MSGBOX_ID id);
@@ -96,9 +89,12 @@ ROUTER_PORT *find_snet(MSGBOX_ID id);
 /* get sending router port */
 ROUTER_PORT *find_dnet(uint16_t net, BACNET_ADDRESS *addr);
 
+/* add router port to the routing table */
+bool add_port(ROUTER_PORT *port);
+
 /* add reacheble network for specified router port */
 void add_dnet(RT_ENTRY *route_info, uint16_t net, BACNET_ADDRESS addr);
 
-void cleanup_dnets(DNET *dnets);
+void cleanup_dnets(void);
 
 #endif /* end of PORTTHREAD_H */
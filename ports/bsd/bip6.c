@@ -97,6 +97,15 @@ static int BIP6_Socket_Scope_Id = 0;
 static BACNET_IP6_ADDRESS BIP6_Addr;
 static BACNET_IP6_ADDRESS BIP6_Broadcast_Addr;
 
+/**
+ * @brief Return the active BIP6 socket.
+ * @return The active BIP6 socket, or -1 if uninitialized.
+ */
+int bip6_get_socket(void)
+{
+    return BIP6_Socket;
+}
+
 /**
  * Set the interface name. On BSD, ifname is the /dev/ name of the interface.
  *
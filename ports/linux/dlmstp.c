@@ -13,6 +13,8 @@
 #include <string.h>
 #include <stdio.h>
 #include <sys/time.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
 /* BACnet Stack defines - first */
 #include "bacnet/bacdef.h"
 /* BACnet Stack API */
@@ -37,6 +39,8 @@ static RING_BUFFER Receive_Queue;
 /* mechanism to wait for a packet */
 static pthread_cond_t Receive_Packet_Flag;
 static pthread_mutex_t Receive_Packet_Mutex;
+/* readable while the receive queue holds a packet - for poll or epoll */
+static int Receive_Event_Fd = -1;
 static pthread_cond_t Received_Frame_Flag;
 static pthread_mutex_t Received_Frame_Mutex;
 static pthread_cond_t Master_Done_Flag;
@@ -92,6 +96,10 @@ void dlmstp_cleanup(void)
     pthread_mutex_destroy(&Receive_Packet_Mutex);
     pthread_mutex_destroy(&Master_Done_Mutex);
     pthread_mutex_destroy(&Ring_Buffer_Mutex);
+    if (Receive_Event_Fd >= 0) {
+        close(Receive_Event_Fd);
+        Receive_Event_Fd = -1;
+    }
     DLMSTP_Initialized = false;
 }
 
@@ -315,6 +323,9 @@ uint16_t MSTP_Put_Receive(struct mstp_port_struct_t *mstp_port)
         pkt->ready = true;
         if (Ringbuf_Data_Put(&Receive_Queue, pkt)) {
             pthread_cond_signal(&Receive_Packet_Flag);
+            if (Receive_Event_Fd >= 0) {
+                (void)eventfd_write(Receive_Event_Fd, 1);
+            }
         }
     }
     pthread_mutex_unlock(&Receive_Packet_Mutex);
@@ -363,11 +374,28 @@ uint16_t dlmstp_receive(
         pkt->ready = false;
         (void)Ringbuf_Pop(&Receive_Queue, NULL);
     }
+    if ((Receive_Event_Fd >= 0) && Ringbuf_Empty(&Receive_Queue)) {
+        /* the queue is drained - clear the event while locked so that
+           a packet queued after this is signaled again */
+        eventfd_t value;
+        (void)eventfd_read(Receive_Event_Fd, &value);
+    }
     pthread_mutex_unlock(&Receive_Packet_Mutex);
 
     return pdu_len;
 }
 
+/**
+ * @brief Get a descriptor that is readable while a received packet is
+ *  waiting for dlmstp_receive(), so that the datalink can be served by
+ *  select(), poll() or epoll() along with other descriptors.
+ * @return file descriptor, or -1 if not available
+ */
+int dlmstp_receive_fd(void)
+{
+    return Receive_Event_Fd;
+}
+
 /**
  * @brief Thread for the MS/TP state machines
  * @param pArg not used
@@ -379,6 +407,7 @@ static void *dlmstp_thread(void *pArg)
     bool thread_alive = true;
     bool run_loop;
     MSTP_MASTER_STATE master_state;
+    MSTP_RECEIVE_STATE receive_state;
 
     (void)pArg;
     while (thread_alive) {
@@ -386,9 +415,14 @@ static void *dlmstp_thread(void *pArg)
         if ((MSTP_Port.ReceivedValidFrame == false) &&
             (MSTP_Port.ReceivedValidFrameNotForUs == false) &&
             (MSTP_Port.ReceivedInvalidFrame == false)) {
-            RS485_Check_UART_Data(&MSTP_Port);
-            MSTP_Receive_Frame_FSM(&MSTP_Port);
-            if (MSTP_Port.receive_state == MSTP_RECEIVE_STATE_PREAMBLE) {
+            receive_state = MSTP_Port.receive_state;
+            RS485_Receive_Frame_Data(&MSTP_Port);
+            if ((receive_state == MSTP_RECEIVE_STATE_IDLE) &&
+                ((MSTP_Port.receive_state != MSTP_RECEIVE_STATE_IDLE) ||
+                 MSTP_Port.ReceivedValidFrame ||
+                 MSTP_Port.ReceivedValidFrameNotForUs ||
+                 MSTP_Port.ReceivedInvalidFrame)) {
+                /* a preamble was received */
                 if (Preamble_Callback) {
                     Preamble_Callback();
                 }
@@ -965,6 +999,7 @@ bool dlmstp_init(const char *ifname)
             ifname);
         exit(1);
     }
+    Receive_Event_Fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
     clock_gettime(CLOCK_MONOTONIC, &Clock_Get_Time_Start);
     /* initialize hardware */
     mstimer_set(&Silence_Timer, 0);
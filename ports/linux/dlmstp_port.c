@@ -25,6 +25,7 @@
 #include "rs485.h"
 /* OS Specific include */
 #include "bacport.h"
+#include <poll.h>
 
 #define BACNET_PDU_CONTROL_BYTE_OFFSET 1
 #define BACNET_DATA_EXPECTING_REPLY_BIT 2
@@ -38,8 +39,8 @@
     }
 static uint32_t Timer_Silence(void *poPort)
 {
-    int32_t res;
-    struct timeval now, tmp_diff;
+    int64_t milliseconds;
+    struct timespec now;
     SHARED_MSTP_DATA *poSharedData;
     struct mstp_port_struct_t *mstp_port = (struct mstp_port_struct_t *)poPort;
     if (!mstp_port) {
@@ -50,11 +51,15 @@ static uint32_t Timer_Silence(void *poPort)
         return -1;
     }
 
-    gettimeofday(&now, NULL);
-    timersub(&poSharedData->start, &now, &tmp_diff);
-    res = ((tmp_diff.tv_sec) * 1000 + (tmp_diff.tv_usec) / 1000);
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    milliseconds = (int64_t)(now.tv_sec - poSharedData->start.tv_sec) * 1000;
+    milliseconds += (now.tv_nsec - poSharedData->start.tv_nsec) / 1000000;
+    if (milliseconds < 0) {
+        /* octets are still being sent */
+        return 0;
+    }
 
-    return (res >= 0 ? res : -res);
+    return (uint32_t)milliseconds;
 }
 
 static void Timer_Silence_Reset(void *poPort)
@@ -69,7 +74,7 @@ static void Timer_Silence_Reset(void *poPort)
         return;
     }
 
-    gettimeofday(&poSharedData->start, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &poSharedData->start);
 }
 
 static void get_abstime(struct timespec *abstime, unsigned long milliseconds)
@@ -192,6 +197,113 @@ uint16_t dlmstp_receive(
     return pdu_len;
 }
 
+/**
+ * @brief Count a newly received frame in the port statistics
+ * @param mstp_port - port specific data
+ */
+static void dlmstp_port_frame_statistics(struct mstp_port_struct_t *mstp_port)
+{
+    SHARED_MSTP_DATA *poSharedData = (SHARED_MSTP_DATA *)mstp_port->UserData;
+
+    if (mstp_port->ReceivedValidFrame) {
+        poSharedData->Statistics.receive_valid_frame_counter++;
+        if (mstp_port->FrameType == FRAME_TYPE_POLL_FOR_MASTER) {
+            poSharedData->Statistics.poll_for_master_counter++;
+        }
+    } else if (mstp_port->ReceivedValidFrameNotForUs) {
+        poSharedData->Statistics.receive_valid_frame_not_for_us_counter++;
+    } else if (mstp_port->ReceivedInvalidFrame) {
+        poSharedData->Statistics.receive_invalid_frame_counter++;
+        if ((mstp_port->HeaderCRC != 0x55) ||
+            (mstp_port->DataCRC != 0xF0B8)) {
+            poSharedData->Statistics.bad_crc_counter++;
+        }
+    }
+}
+
+/**
+ * @brief Get the time until the node state machine has a timeout
+ * @param mstp_port - port specific data
+ * @return milliseconds until the node state machine needs to run,
+ *  or 0 if it needs to run now
+ */
+static uint32_t dlmstp_port_timeout(struct mstp_port_struct_t *mstp_port)
+{
+    uint32_t silence, timeout;
+
+    switch (mstp_port->master_state) {
+        case MSTP_MASTER_STATE_IDLE:
+            timeout = Tno_token;
+            break;
+        case MSTP_MASTER_STATE_NO_TOKEN:
+            timeout = Tno_token + (Tslot * mstp_port->This_Station);
+            break;
+        case MSTP_MASTER_STATE_WAIT_FOR_REPLY:
+            timeout = mstp_port->Treply_timeout;
+            break;
+        case MSTP_MASTER_STATE_POLL_FOR_MASTER:
+        case MSTP_MASTER_STATE_PASS_TOKEN:
+            timeout = mstp_port->Tusage_timeout + 1;
+            break;
+        case MSTP_MASTER_STATE_ANSWER_DATA_REQUEST:
+            /* poll for the reply from the application */
+            return 1;
+        default:
+            return 0;
+    }
+    if (mstp_port->receive_state != MSTP_RECEIVE_STATE_IDLE) {
+        /* a partial frame is aborted after Tframe_abort */
+        if (timeout > (uint32_t)mstp_port->Tframe_abort + 1) {
+            timeout = mstp_port->Tframe_abort + 1;
+        }
+    }
+    silence = mstp_port->SilenceTimer(mstp_port);
+    if (silence >= timeout) {
+        return 0;
+    }
+
+    return timeout - silence;
+}
+
+/**
+ * @brief Run the node state machine when a frame was received
+ *  or a timeout has expired
+ * @param mstp_port - port specific data
+ * @return milliseconds until the node state machine needs to run again
+ */
+static uint32_t dlmstp_port_fsm(struct mstp_port_struct_t *mstp_port)
+{
+    SHARED_MSTP_DATA *poSharedData = (SHARED_MSTP_DATA *)mstp_port->UserData;
+    MSTP_MASTER_STATE master_state;
+    bool run_master = false;
+
+    if (mstp_port->ReceivedValidFrame || mstp_port->ReceivedInvalidFrame ||
+        mstp_port->ReceivedValidFrameNotForUs) {
+        run_master = true;
+    } else if (dlmstp_port_timeout(mstp_port) == 0) {
+        run_master = true;
+    }
+    if (run_master) {
+        if (mstp_port->This_Station <= DEFAULT_MAX_MASTER) {
+            master_state = mstp_port->master_state;
+            while (MSTP_Master_Node_FSM(mstp_port)) {
+                /* do nothing while immediate transitioning */
+                if (master_state != mstp_port->master_state) {
+                    if (mstp_port->master_state ==
+                        MSTP_MASTER_STATE_NO_TOKEN) {
+                        poSharedData->Statistics.lost_token_counter++;
+                    }
+                    master_state = mstp_port->master_state;
+                }
+            }
+        } else if (mstp_port->This_Station < 255) {
+            MSTP_Slave_Node_FSM(mstp_port);
+        }
+    }
+
+    return dlmstp_port_timeout(mstp_port);
+}
+
 static void *dlmstp_receive_fsm_task(void *pArg)
 {
     bool received_frame;
@@ -213,8 +325,7 @@ static void *dlmstp_receive_fsm_task(void *pArg)
             (mstp_port->ReceivedValidFrameNotForUs == false) &&
             (mstp_port->ReceivedInvalidFrame == false)) {
             do {
-                RS485_Check_UART_Data(mstp_port);
-                MSTP_Receive_Frame_FSM((struct mstp_port_struct_t *)pArg);
+                RS485_Receive_Frame_Data(mstp_port);
                 received_frame = mstp_port->ReceivedValidFrame ||
                     mstp_port->ReceivedValidFrameNotForUs ||
                     mstp_port->ReceivedInvalidFrame;
@@ -231,8 +342,6 @@ static void *dlmstp_receive_fsm_task(void *pArg)
 
 static void *dlmstp_master_fsm_task(void *pArg)
 {
-    uint32_t silence = 0;
-    bool run_master = false;
     SHARED_MSTP_DATA *poSharedData;
     struct mstp_port_struct_t *mstp_port = (struct mstp_port_struct_t *)pArg;
     if (!mstp_port) {
@@ -249,47 +358,134 @@ static void *dlmstp_master_fsm_task(void *pArg)
         if (mstp_port->ReceivedValidFrame == false &&
             mstp_port->ReceivedValidFrameNotForUs == false &&
             mstp_port->ReceivedInvalidFrame == false) {
-            RS485_Check_UART_Data(mstp_port);
-            MSTP_Receive_Frame_FSM(mstp_port);
+            RS485_Receive_Frame_Data(mstp_port);
+            dlmstp_port_frame_statistics(mstp_port);
         }
-        if (mstp_port->ReceivedValidFrame || mstp_port->ReceivedInvalidFrame ||
-            mstp_port->ReceivedValidFrameNotForUs) {
-            run_master = true;
-        } else {
-            silence = mstp_port->SilenceTimer(NULL);
-            switch (mstp_port->master_state) {
-                case MSTP_MASTER_STATE_IDLE:
-                    if (silence >= Tno_token) {
-                        run_master = true;
-                    }
-                    break;
-                case MSTP_MASTER_STATE_WAIT_FOR_REPLY:
-                    if (silence >= mstp_port->Treply_timeout) {
-                        run_master = true;
-                    }
-                    break;
-                case MSTP_MASTER_STATE_POLL_FOR_MASTER:
-                    if (silence >= mstp_port->Tusage_timeout) {
-                        run_master = true;
-                    }
-                    break;
-                default:
-                    run_master = true;
-                    break;
-            }
+        (void)dlmstp_port_fsm(mstp_port);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Receive the waiting octets, and run the receive and node state
+ *  machines of a port that is serviced by an event loop.  The serial
+ *  port descriptor is non-blocking, so this never waits for octets.
+ * @param poPort - port specific data opened with dlmstp_port_open()
+ * @return milliseconds until this function needs to be called again
+ *  if no octets are received before then
+ */
+uint32_t dlmstp_port_task(void *poPort)
+{
+    uint8_t buf[2048];
+    ssize_t n;
+    unsigned count;
+    size_t used;
+    uint32_t timeout;
+    bool received_frame;
+    SHARED_MSTP_DATA *poSharedData;
+    struct mstp_port_struct_t *mstp_port = (struct mstp_port_struct_t *)poPort;
+    if (!mstp_port) {
+        return 0;
+    }
+    poSharedData = (SHARED_MSTP_DATA *)mstp_port->UserData;
+    if (!poSharedData) {
+        return 0;
+    }
+    /* drain the serial port into the FIFO */
+    while (FIFO_Available(&poSharedData->Rx_FIFO, sizeof(buf))) {
+        n = read(poSharedData->RS485_Handle, buf, sizeof(buf));
+        if (n <= 0) {
+            break;
         }
-        if (run_master) {
-            if (mstp_port->This_Station <= DEFAULT_MAX_MASTER) {
-                while (MSTP_Master_Node_FSM(mstp_port)) {
-                    /* do nothing while immediate transitioning */
-                }
-            } else if (mstp_port->This_Station < 255) {
-                MSTP_Slave_Node_FSM(mstp_port);
+        FIFO_Add(&poSharedData->Rx_FIFO, &buf[0], (unsigned)n);
+    }
+    for (;;) {
+        if ((mstp_port->ReceivedValidFrame == false) &&
+            (mstp_port->ReceivedValidFrameNotForUs == false) &&
+            (mstp_port->ReceivedInvalidFrame == false)) {
+            count = FIFO_Peek_Ahead(&poSharedData->Rx_FIFO, buf, sizeof(buf));
+            if (count > 0) {
+                used = MSTP_Receive_Frame_Buffer(mstp_port, buf, count);
+                (void)FIFO_Pull(&poSharedData->Rx_FIFO, NULL, (unsigned)used);
+            } else {
+                /* no data - let the state machine check for timeouts */
+                MSTP_Receive_Frame_FSM(mstp_port);
             }
+            dlmstp_port_frame_statistics(mstp_port);
+        }
+        received_frame = mstp_port->ReceivedValidFrame ||
+            mstp_port->ReceivedValidFrameNotForUs ||
+            mstp_port->ReceivedInvalidFrame;
+        timeout = dlmstp_port_fsm(mstp_port);
+        if (!received_frame || FIFO_Empty(&poSharedData->Rx_FIFO) ||
+            mstp_port->ReceivedValidFrame ||
+            mstp_port->ReceivedValidFrameNotForUs ||
+            mstp_port->ReceivedInvalidFrame) {
+            /* octets after a frame are received in the next pass */
+            break;
         }
     }
 
-    return NULL;
+    return timeout;
+}
+
+/**
+ * @brief Get the serial port descriptor of a port
+ * @param poPort - port specific data
+ * @return descriptor that is readable when octets are received, or -1
+ */
+int dlmstp_port_handle(void *poPort)
+{
+    SHARED_MSTP_DATA *poSharedData;
+    struct mstp_port_struct_t *mstp_port = (struct mstp_port_struct_t *)poPort;
+    if (!mstp_port) {
+        return -1;
+    }
+    poSharedData = (SHARED_MSTP_DATA *)mstp_port->UserData;
+    if (!poSharedData) {
+        return -1;
+    }
+
+    return poSharedData->RS485_Handle;
+}
+
+/**
+ * @brief Copy the packet and token statistics of a port
+ * @param poPort - port specific data
+ * @param statistics - where the statistics are copied
+ */
+void dlmstp_port_statistics(
+    void *poPort, struct dlmstp_statistics *statistics)
+{
+    SHARED_MSTP_DATA *poSharedData;
+    struct mstp_port_struct_t *mstp_port = (struct mstp_port_struct_t *)poPort;
+    if (!mstp_port || !statistics) {
+        return;
+    }
+    poSharedData = (SHARED_MSTP_DATA *)mstp_port->UserData;
+    if (!poSharedData) {
+        return;
+    }
+    *statistics = poSharedData->Statistics;
+}
+
+/**
+ * @brief Clear the packet and token statistics of a port
+ * @param poPort - port specific data
+ */
+void dlmstp_port_statistics_reset(void *poPort)
+{
+    SHARED_MSTP_DATA *poSharedData;
+    struct mstp_port_struct_t *mstp_port = (struct mstp_port_struct_t *)poPort;
+    if (!mstp_port) {
+        return;
+    }
+    poSharedData = (SHARED_MSTP_DATA *)mstp_port->UserData;
+    if (!poSharedData) {
+        return;
+    }
+    memset(&poSharedData->Statistics, 0, sizeof(poSharedData->Statistics));
 }
 
 void dlmstp_fill_bacnet_address(BACNET_ADDRESS *src, uint8_t mstp_address)
@@ -338,6 +534,7 @@ uint16_t MSTP_Put_Receive(struct mstp_port_struct_t *mstp_port)
             &poSharedData->Receive_Packet.address, mstp_port->SourceAddress);
         poSharedData->Receive_Packet.pdu_len = mstp_port->DataLength;
         poSharedData->Receive_Packet.ready = true;
+        poSharedData->Statistics.receive_pdu_counter++;
         sem_post(&poSharedData->Receive_Packet_Flag);
     }
 
@@ -373,10 +570,61 @@ uint16_t MSTP_Get_Send(struct mstp_port_struct_t *mstp_port, unsigned timeout)
         mstp_port->OutputBufferSize, frame_type, pkt->destination_mac,
         mstp_port->This_Station, (uint8_t *)&pkt->buffer[0], pkt->length);
     (void)Ringbuf_Pop(&poSharedData->PDU_Queue, NULL);
+    poSharedData->Statistics.transmit_pdu_counter++;
 
     return pdu_len;
 }
 
+/**
+ * @brief Write a frame to the non-blocking serial port of a polled port
+ *  without waiting for it to be sent.  The line silence starts when
+ *  the octets still in the output queue have been sent.
+ * @param mstp_port - port specific data
+ * @param buffer - data to send
+ * @param nbytes - number of bytes of data to send
+ */
+static void dlmstp_port_write(
+    struct mstp_port_struct_t *mstp_port,
+    const uint8_t *buffer,
+    uint16_t nbytes)
+{
+    SHARED_MSTP_DATA *poSharedData = (SHARED_MSTP_DATA *)mstp_port->UserData;
+    struct pollfd output = { 0 };
+    uint64_t nanoseconds;
+    ssize_t written;
+    int queued = 0;
+    uint32_t baud;
+
+    output.fd = poSharedData->RS485_Handle;
+    output.events = POLLOUT;
+    while (nbytes > 0) {
+        written = write(poSharedData->RS485_Handle, buffer, nbytes);
+        if (written > 0) {
+            buffer += written;
+            nbytes -= (uint16_t)written;
+        } else if ((written < 0) && (errno == EAGAIN)) {
+            /* output queue is full */
+            if (poll(&output, 1, 100) <= 0) {
+                break;
+            }
+        } else if ((written < 0) && (errno == EINTR)) {
+            continue;
+        } else {
+            debug_perror("MS/TP write");
+            break;
+        }
+    }
+    Timer_Silence_Reset(mstp_port);
+    if (ioctl(poSharedData->RS485_Handle, TIOCOUTQ, &queued) == 0) {
+        /* start, 8 data, and stop bit for each octet */
+        baud = dlmstp_baud_rate(mstp_port);
+        nanoseconds = ((uint64_t)queued * 10 * 1000000000ULL) / baud;
+        nanoseconds += poSharedData->start.tv_nsec;
+        poSharedData->start.tv_sec += nanoseconds / 1000000000ULL;
+        poSharedData->start.tv_nsec = nanoseconds % 1000000000ULL;
+    }
+}
+
 /**
  * @brief Send an MSTP frame
  * @param mstp_port - port specific data
@@ -388,7 +636,16 @@ void MSTP_Send_Frame(
     const uint8_t *buffer,
     uint16_t nbytes)
 {
-    RS485_Send_Frame(mstp_port, buffer, nbytes);
+    SHARED_MSTP_DATA *poSharedData = (SHARED_MSTP_DATA *)mstp_port->UserData;
+
+    if (poSharedData) {
+        poSharedData->Statistics.transmit_frame_counter++;
+    }
+    if (poSharedData && poSharedData->Polled) {
+        dlmstp_port_write(mstp_port, buffer, nbytes);
+    } else {
+        RS485_Send_Frame(mstp_port, buffer, nbytes);
+    }
 }
 
 /* Get the reply to a DATA_EXPECTING_REPLY frame, or nothing */
@@ -440,6 +697,7 @@ uint16_t MSTP_Get_Reply(struct mstp_port_struct_t *mstp_port, unsigned timeout)
         mstp_port->This_Station, (uint8_t *)&pkt->buffer[0], pkt->length);
     /* This will pop the element no matter where we found it */
     (void)Ringbuf_Pop_Element(&poSharedData->PDU_Queue, (uint8_t *)pkt, NULL);
+    poSharedData->Statistics.transmit_pdu_counter++;
 
     return pdu_len;
 }
@@ -634,9 +892,16 @@ void dlmstp_get_broadcast_address(BACNET_ADDRESS *dest)
     return;
 }
 
-bool dlmstp_init(void *poPort, const char *ifname)
+/**
+ * @brief Open and configure the serial port, and initialize the MS/TP
+ *  state machines of a port
+ * @param poPort - port specific data
+ * @param ifname - serial port name
+ * @param polled - true if the port is serviced by dlmstp_port_task()
+ * @return true if the port was initialized
+ */
+static bool dlmstp_port_setup(void *poPort, const char *ifname, bool polled)
 {
-    unsigned long hThread = 0;
     int rv = 0;
     SHARED_MSTP_DATA *poSharedData;
     struct termios2 newtio;
@@ -680,13 +945,11 @@ bool dlmstp_init(void *poPort, const char *ifname)
         perror(poSharedData->RS485_Port_Name);
         exit(-1);
     }
-#if 0
-    /* non blocking for the read */
-    fcntl(poSharedData->RS485_Handle, F_SETFL, FNDELAY);
-#else
-    /* efficient blocking for the read */
-    fcntl(poSharedData->RS485_Handle, F_SETFL, 0);
-#endif
+    poSharedData->Polled = polled;
+    if (!polled) {
+        /* efficient blocking for the read */
+        fcntl(poSharedData->RS485_Handle, F_SETFL, 0);
+    }
     /* save current serial port settings */
     termios2_tcgetattr(
         poSharedData->RS485_Handle, &poSharedData->RS485_oldtio2);
@@ -724,7 +987,7 @@ bool dlmstp_init(void *poPort, const char *ifname)
     mstp_port->InputBufferSize = sizeof(poSharedData->RxBuffer);
     mstp_port->OutputBuffer = &poSharedData->TxBuffer[0];
     mstp_port->OutputBufferSize = sizeof(poSharedData->TxBuffer);
-    gettimeofday(&poSharedData->start, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &poSharedData->start);
     mstp_port->SilenceTimer = Timer_Silence;
     mstp_port->SilenceTimerReset = Timer_Silence_Reset;
     MSTP_Init(mstp_port);
@@ -732,6 +995,32 @@ bool dlmstp_init(void *poPort, const char *ifname)
     debug_fprintf(stderr, "MS/TP Max_Master: %02X\n", mstp_port->Nmax_master);
     debug_fprintf(
         stderr, "MS/TP Max_Info_Frames: %u\n", mstp_port->Nmax_info_frames);
+
+    return true;
+}
+
+/**
+ * @brief Initialize a port that is serviced by an event loop calling
+ *  dlmstp_port_task() when dlmstp_port_handle() is readable, or when
+ *  the time it returned has elapsed.  No thread is started.
+ * @param poPort - port specific data
+ * @param ifname - serial port name
+ * @return true if the port was initialized
+ */
+bool dlmstp_port_open(void *poPort, const char *ifname)
+{
+    return dlmstp_port_setup(poPort, ifname, true);
+}
+
+bool dlmstp_init(void *poPort, const char *ifname)
+{
+    unsigned long hThread = 0;
+    int rv = 0;
+    struct mstp_port_struct_t *mstp_port = (struct mstp_port_struct_t *)poPort;
+
+    if (!dlmstp_port_setup(poPort, ifname, false)) {
+        return false;
+    }
     rv = pthread_create(&hThread, NULL, dlmstp_master_fsm_task, mstp_port);
     if (rv != 0) {
         fprintf(stderr, "Failed to start Master Node FSM task\n");
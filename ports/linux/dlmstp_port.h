@@ -12,6 +12,7 @@
 /*#include "bacnet/datalink/dlmstp.h" */
 #include <sys/types.h>
 #include <semaphore.h>
+#include <time.h>
 
 #include <stdbool.h>
 #include <stdint.h>
@@ -90,7 +91,12 @@ typedef struct shared_mstp_data {
     FIFO_BUFFER Rx_FIFO;
     /* buffer size needs to be a power of 2 */
     uint8_t Rx_Buffer[4096];
-    struct timeval start;
+    /* CLOCK_MONOTONIC time of the end of the last octet on the line */
+    struct timespec start;
+    /* true if serviced by dlmstp_port_task() instead of a thread */
+    bool Polled;
+    /* packet and token statistics of this port */
+    struct dlmstp_statistics Statistics;
 
     RING_BUFFER PDU_Queue;
 
@@ -109,6 +115,18 @@ void dlmstp_reset(void *poShared);
 BACNET_STACK_EXPORT
 void dlmstp_cleanup(void *poShared);
 
+BACNET_STACK_EXPORT
+bool dlmstp_port_open(void *poShared, const char *ifname);
+BACNET_STACK_EXPORT
+int dlmstp_port_handle(void *poShared);
+BACNET_STACK_EXPORT
+uint32_t dlmstp_port_task(void *poShared);
+BACNET_STACK_EXPORT
+void dlmstp_port_statistics(
+    void *poShared, struct dlmstp_statistics *statistics);
+BACNET_STACK_EXPORT
+void dlmstp_port_statistics_reset(void *poShared);
+
 /* returns number of bytes sent on success, negative on failure */
 BACNET_STACK_EXPORT
 int dlmstp_send_pdu(
@@ -0,0 +1,384 @@
+/**
+ * @file
+ * @brief An epoll driver that services many MS/TP trunks from a small
+ *  number of threads.
+ *
+ * Each trunk is an MS/TP port opened with dlmstp_port_open(), so that
+ * it has a non-blocking serial port descriptor and no thread of its own.
+ * The trunks are sharded across worker threads, each with its own epoll
+ * set. A worker runs the state machines of a trunk with dlmstp_port_task()
+ * when its serial port is readable, or when its timerfd expires. The
+ * timerfd is armed with the time until the next MS/TP timeout
+ * (Tno_token, Treply_timeout, Tusage_timeout, or Tframe_abort) that
+ * dlmstp_port_task() returns, so an idle trunk costs no CPU time.
+ * The application sends and receives on each trunk with the dlmstp
+ * functions of dlmstp_port.h, as before.
+ *
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2026
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include "bacnet/basic/sys/debug.h"
+#include "dlmstp_port.h"
+#include "mstp-trunks.h"
+
+/* epoll data tag that is not a trunk */
+#define MSTP_TRUNKS_TAG_STOP UINT32_MAX
+/* epoll data tags of a trunk: serial port and timer */
+#define MSTP_TRUNKS_TAG(index, timer) (((uint32_t)(index) << 1) | (timer))
+
+struct mstp_trunk {
+    /* port specific data, or NULL if the trunk is not used */
+    void *port;
+    int timer_fd;
+    unsigned worker;
+    pthread_mutex_t mutex;
+};
+
+struct mstp_trunks_worker {
+    int epoll_fd;
+    pthread_t thread;
+    bool thread_started;
+};
+
+static struct mstp_trunk Trunks[MSTP_TRUNKS_MAX];
+static struct mstp_trunks_worker Workers[MSTP_TRUNKS_WORKERS_MAX];
+static unsigned Worker_Count;
+static int Stop_Fd = -1;
+static pthread_mutex_t Trunks_Mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Run the state machines of a trunk, and arm its timer with
+ *  the time until the next MS/TP timeout
+ * @param trunk - trunk to service
+ * @param timer - true if woken by the timer
+ */
+static void mstp_trunk_service(struct mstp_trunk *trunk, bool timer)
+{
+    struct itimerspec timeout = { 0 };
+    uint64_t expirations = 0;
+    uint32_t milliseconds;
+
+    pthread_mutex_lock(&trunk->mutex);
+    if (trunk->port) {
+        if (timer) {
+            (void)!read(trunk->timer_fd, &expirations, sizeof(expirations));
+        }
+        milliseconds = dlmstp_port_task(trunk->port);
+        if (milliseconds == 0) {
+            /* a zero timer value would disarm the timer */
+            milliseconds = 1;
+        }
+        timeout.it_value.tv_sec = milliseconds / 1000;
+        timeout.it_value.tv_nsec = (milliseconds % 1000) * 1000000L;
+        if (timerfd_settime(trunk->timer_fd, 0, &timeout, NULL) != 0) {
+            debug_perror("mstp-trunks: timerfd_settime");
+        }
+    }
+    pthread_mutex_unlock(&trunk->mutex);
+}
+
+/**
+ * @brief Wait for and handle the events of one worker until stopped
+ * @param arg - worker to run
+ * @return NULL
+ */
+static void *mstp_trunks_worker_thread(void *arg)
+{
+    struct mstp_trunks_worker *worker = (struct mstp_trunks_worker *)arg;
+    struct epoll_event events[MSTP_TRUNKS_MAX * 2 + 1];
+    int count, i;
+    uint32_t tag;
+
+    for (;;) {
+        count = epoll_wait(
+            worker->epoll_fd, events, sizeof(events) / sizeof(events[0]),
+            -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            debug_perror("mstp-trunks: epoll_wait");
+            break;
+        }
+        for (i = 0; i < count; i++) {
+            tag = events[i].data.u32;
+            if (tag == MSTP_TRUNKS_TAG_STOP) {
+                return NULL;
+            } else if ((tag >> 1) < MSTP_TRUNKS_MAX) {
+                mstp_trunk_service(&Trunks[tag >> 1], tag & 1);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Add a descriptor to the epoll set of a worker
+ * @param worker - worker owning the descriptor
+ * @param fd - descriptor to watch for input
+ * @param tag - trunk or special tag returned by epoll_wait
+ * @return true if added
+ */
+static bool
+mstp_trunks_watch(struct mstp_trunks_worker *worker, int fd, uint32_t tag)
+{
+    struct epoll_event event = { 0 };
+
+    event.events = EPOLLIN;
+    event.data.u32 = tag;
+
+    return epoll_ctl(worker->epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+
+/**
+ * @brief Create the epoll sets and start the worker threads
+ * @param workers - number of threads to shard the trunks across,
+ *  or 0 for MSTP_TRUNKS_WORKERS
+ * @return true if the driver was started
+ */
+bool mstp_trunks_init(unsigned workers)
+{
+    struct mstp_trunks_worker *worker;
+    unsigned i;
+    bool status = true;
+
+    if (Worker_Count > 0) {
+        return false;
+    }
+    if (workers == 0) {
+        workers = MSTP_TRUNKS_WORKERS;
+    }
+    if (workers > MSTP_TRUNKS_WORKERS_MAX) {
+        workers = MSTP_TRUNKS_WORKERS_MAX;
+    }
+    for (i = 0; i < MSTP_TRUNKS_MAX; i++) {
+        Trunks[i].port = NULL;
+        Trunks[i].timer_fd = -1;
+        if (pthread_mutex_init(&Trunks[i].mutex, NULL) != 0) {
+            return false;
+        }
+    }
+    Stop_Fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (Stop_Fd < 0) {
+        return false;
+    }
+    for (i = 0; i < workers; i++) {
+        worker = &Workers[i];
+        worker->thread_started = false;
+        worker->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        Worker_Count++;
+        if (worker->epoll_fd < 0) {
+            status = false;
+            break;
+        }
+        /* the stop event is never cleared, so it wakes every worker */
+        if (!mstp_trunks_watch(worker, Stop_Fd, MSTP_TRUNKS_TAG_STOP)) {
+            status = false;
+            break;
+        }
+        if (pthread_create(
+                &worker->thread, NULL, mstp_trunks_worker_thread, worker) !=
+            0) {
+            debug_perror("mstp-trunks: pthread_create");
+            status = false;
+            break;
+        }
+        worker->thread_started = true;
+    }
+    if (!status) {
+        mstp_trunks_cleanup();
+    }
+
+    return status;
+}
+
+/**
+ * @brief Add an MS/TP port to the driver
+ * @param poPort - port specific data opened with dlmstp_port_open()
+ * @return index of the trunk, or -1 if the trunk could not be added
+ */
+int mstp_trunks_add(void *poPort)
+{
+    struct mstp_trunk *trunk = NULL;
+    struct mstp_trunks_worker *worker;
+    struct itimerspec timeout = { 0 };
+    int fd, index = -1;
+    unsigned i;
+
+    fd = dlmstp_port_handle(poPort);
+    if (fd < 0) {
+        return -1;
+    }
+    pthread_mutex_lock(&Trunks_Mutex);
+    for (i = 0; (i < MSTP_TRUNKS_MAX) && (Worker_Count > 0); i++) {
+        if ((Trunks[i].port == NULL) && (Trunks[i].timer_fd < 0)) {
+            trunk = &Trunks[i];
+            index = (int)i;
+            break;
+        }
+    }
+    if (trunk) {
+        trunk->timer_fd =
+            timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (trunk->timer_fd < 0) {
+            index = -1;
+        }
+    }
+    if (index >= 0) {
+        trunk->worker = i % Worker_Count;
+        worker = &Workers[trunk->worker];
+        pthread_mutex_lock(&trunk->mutex);
+        trunk->port = poPort;
+        pthread_mutex_unlock(&trunk->mutex);
+        if (!mstp_trunks_watch(worker, fd, MSTP_TRUNKS_TAG(index, 0)) ||
+            !mstp_trunks_watch(
+                worker, trunk->timer_fd, MSTP_TRUNKS_TAG(index, 1))) {
+            debug_perror("mstp-trunks: epoll_ctl");
+            pthread_mutex_unlock(&Trunks_Mutex);
+            (void)mstp_trunks_remove(index);
+            return -1;
+        }
+        /* start the state machines */
+        timeout.it_value.tv_nsec = 1000000L;
+        (void)timerfd_settime(trunk->timer_fd, 0, &timeout, NULL);
+    }
+    pthread_mutex_unlock(&Trunks_Mutex);
+
+    return index;
+}
+
+/**
+ * @brief Remove an MS/TP port from the driver.  Afterwards the port is
+ *  no longer serviced, and may be closed with dlmstp_cleanup().
+ * @param index - index of the trunk returned by mstp_trunks_add()
+ * @return true if the trunk was removed
+ */
+bool mstp_trunks_remove(int index)
+{
+    struct mstp_trunk *trunk;
+    int fd;
+
+    if ((index < 0) || (index >= MSTP_TRUNKS_MAX)) {
+        return false;
+    }
+    trunk = &Trunks[index];
+    pthread_mutex_lock(&Trunks_Mutex);
+    pthread_mutex_lock(&trunk->mutex);
+    if (trunk->timer_fd < 0) {
+        pthread_mutex_unlock(&trunk->mutex);
+        pthread_mutex_unlock(&Trunks_Mutex);
+        return false;
+    }
+    fd = dlmstp_port_handle(trunk->port);
+    if (fd >= 0) {
+        (void)epoll_ctl(
+            Workers[trunk->worker].epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+    }
+    (void)epoll_ctl(
+        Workers[trunk->worker].epoll_fd, EPOLL_CTL_DEL, trunk->timer_fd,
+        NULL);
+    close(trunk->timer_fd);
+    trunk->timer_fd = -1;
+    trunk->port = NULL;
+    pthread_mutex_unlock(&trunk->mutex);
+    pthread_mutex_unlock(&Trunks_Mutex);
+
+    return true;
+}
+
+/**
+ * @brief Get the number of trunks serviced by the driver
+ * @return number of trunks
+ */
+unsigned mstp_trunks_count(void)
+{
+    unsigned count = 0;
+    unsigned i;
+
+    pthread_mutex_lock(&Trunks_Mutex);
+    for (i = 0; i < MSTP_TRUNKS_MAX; i++) {
+        if (Trunks[i].port) {
+            count++;
+        }
+    }
+    pthread_mutex_unlock(&Trunks_Mutex);
+
+    return count;
+}
+
+/**
+ * @brief Copy the packet and token statistics of a trunk
+ * @param index - index of the trunk returned by mstp_trunks_add()
+ * @param statistics - where the statistics are copied
+ * @return true if the trunk exists and the statistics were copied
+ */
+bool mstp_trunks_statistics(int index, struct dlmstp_statistics *statistics)
+{
+    struct mstp_trunk *trunk;
+    bool status = false;
+
+    if ((index < 0) || (index >= MSTP_TRUNKS_MAX) || !statistics) {
+        return false;
+    }
+    trunk = &Trunks[index];
+    pthread_mutex_lock(&trunk->mutex);
+    if (trunk->port) {
+        dlmstp_port_statistics(trunk->port, statistics);
+        status = true;
+    }
+    pthread_mutex_unlock(&trunk->mutex);
+
+    return status;
+}
+
+/**
+ * @brief Stop the worker threads, and release the resources of the
+ *  driver.  The ports are owned by the application and not closed.
+ */
+void mstp_trunks_cleanup(void)
+{
+    uint64_t value = 1;
+    unsigned i;
+
+    if ((Worker_Count == 0) && (Stop_Fd < 0)) {
+        return;
+    }
+    if (Stop_Fd >= 0) {
+        (void)!write(Stop_Fd, &value, sizeof(value));
+    }
+    for (i = 0; i < Worker_Count; i++) {
+        if (Workers[i].thread_started) {
+            pthread_join(Workers[i].thread, NULL);
+            Workers[i].thread_started = false;
+        }
+    }
+    for (i = 0; i < MSTP_TRUNKS_MAX; i++) {
+        if (Trunks[i].timer_fd >= 0) {
+            (void)mstp_trunks_remove((int)i);
+        }
+    }
+    for (i = 0; i < Worker_Count; i++) {
+        if (Workers[i].epoll_fd >= 0) {
+            close(Workers[i].epoll_fd);
+            Workers[i].epoll_fd = -1;
+        }
+    }
+    Worker_Count = 0;
+    for (i = 0; i < MSTP_TRUNKS_MAX; i++) {
+        pthread_mutex_destroy(&Trunks[i].mutex);
+    }
+    if (Stop_Fd >= 0) {
+        close(Stop_Fd);
+        Stop_Fd = -1;
+    }
+}
@@ -0,0 +1,52 @@
+/**
+ * @file
+ * @brief API for an epoll driver that services many MS/TP trunks
+ *  from a small number of threads.
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2026
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#ifndef BACNET_PORT_LINUX_MSTP_TRUNKS_H
+#define BACNET_PORT_LINUX_MSTP_TRUNKS_H
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+/* BACnet Stack defines - first */
+#include "bacnet/bacdef.h"
+/* BACnet Stack API */
+#include "bacnet/datalink/mstpdef.h"
+
+/* maximum number of MS/TP trunks serviced by the driver */
+#ifndef MSTP_TRUNKS_MAX
+#define MSTP_TRUNKS_MAX 32
+#endif
+/* maximum number of worker threads the trunks are sharded across */
+#ifndef MSTP_TRUNKS_WORKERS_MAX
+#define MSTP_TRUNKS_WORKERS_MAX 8
+#endif
+/* default number of worker threads */
+#ifndef MSTP_TRUNKS_WORKERS
+#define MSTP_TRUNKS_WORKERS 2
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+BACNET_STACK_EXPORT
+bool mstp_trunks_init(unsigned workers);
+BACNET_STACK_EXPORT
+int mstp_trunks_add(void *poPort);
+BACNET_STACK_EXPORT
+bool mstp_trunks_remove(int index);
+BACNET_STACK_EXPORT
+unsigned mstp_trunks_count(void);
+BACNET_STACK_EXPORT
+bool mstp_trunks_statistics(int index, struct dlmstp_statistics *statistics);
+BACNET_STACK_EXPORT
+void mstp_trunks_cleanup(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
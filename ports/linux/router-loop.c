@@ -0,0 +1,446 @@
+/**
+ * @file
+ * @brief An epoll event loop that receives from many BACnet datalinks
+ *  and hands each NPDU to a routing handler.
+ *
+ * Each datalink port registers the descriptors that become readable
+ * when the datalink has data (the UDP sockets of BACnet/IP and IPv6,
+ * or the receive eventfd of MS/TP). A port without a descriptor is
+ * polled at ROUTER_LOOP_POLL_INTERVAL. The ports may be sharded across
+ * worker threads, each with its own epoll set, so that the datalink
+ * receive processing of one port never waits behind another port.
+ * The routing handler and timer always run one at a time, under a
+ * dispatch lock, so the application routing state needs no locking.
+ * Each port has a lock held while receiving from or sending to that
+ * datalink, so a send from a handler on one worker can not interleave
+ * with a receive on the port owner worker.
+ *
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2026
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include "bacnet/basic/sys/debug.h"
+#include "router-loop.h"
+
+/* epoll data tags that are not a port index */
+#define ROUTER_LOOP_TAG_STOP UINT32_MAX
+#define ROUTER_LOOP_TAG_TIMER (UINT32_MAX - 1)
+
+struct router_loop_port {
+    uint16_t net;
+    int fd[2];
+    router_loop_receive_function receive;
+    router_loop_send_function send;
+    uint8_t *rx_buffer;
+    uint16_t rx_buffer_size;
+    unsigned worker;
+    pthread_mutex_t mutex;
+};
+
+struct router_loop_worker {
+    int epoll_fd;
+    pthread_t thread;
+    bool thread_started;
+    /* true if the worker owns a port without a descriptor */
+    bool polled;
+};
+
+static struct router_loop_port Ports[ROUTER_LOOP_PORTS_MAX];
+static unsigned Port_Count;
+static struct router_loop_worker Workers[ROUTER_LOOP_WORKERS_MAX];
+static unsigned Worker_Count;
+static int Stop_Fd = -1;
+static int Timer_Fd = -1;
+static router_loop_handler_function Handler;
+static router_loop_timer_function Timer;
+static pthread_mutex_t Dispatch_Mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Initialize the event loop
+ * @param workers - number of threads to shard the ports across,
+ *  1 to run every port in the thread calling router_loop_run()
+ * @param handler - function called with each received NPDU
+ * @param timer - function called about once per second, or NULL
+ * @return true if the loop was initialized
+ */
+bool router_loop_init(
+    unsigned workers,
+    router_loop_handler_function handler,
+    router_loop_timer_function timer)
+{
+    unsigned i;
+
+    if (!handler) {
+        return false;
+    }
+    if (workers == 0) {
+        workers = 1;
+    } else if (workers > ROUTER_LOOP_WORKERS_MAX) {
+        workers = ROUTER_LOOP_WORKERS_MAX;
+    }
+    Stop_Fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (Stop_Fd < 0) {
+        return false;
+    }
+    Worker_Count = workers;
+    for (i = 0; i < Worker_Count; i++) {
+        Workers[i].epoll_fd = -1;
+        Workers[i].thread_started = false;
+        Workers[i].polled = false;
+    }
+    Port_Count = 0;
+    Handler = handler;
+    Timer = timer;
+
+    return true;
+}
+
+/**
+ * @brief Add a datalink port to the event loop
+ * @param net - network number of the directly connected network
+ * @param fd - descriptor that is readable when the datalink has data,
+ *  or -1 to poll the datalink
+ * @param fd2 - second descriptor (i.e. BACnet/IP broadcast socket), or -1
+ * @param receive - datalink receive function, called with timeout 0
+ * @param send - datalink send function
+ * @param rx_buffer - buffer for the packets received by this port
+ * @param rx_buffer_size - size of the receive buffer
+ * @return index of the port, or -1 if the port could not be added
+ */
+int router_loop_port_add(
+    uint16_t net,
+    int fd,
+    int fd2,
+    router_loop_receive_function receive,
+    router_loop_send_function send,
+    uint8_t *rx_buffer,
+    uint16_t rx_buffer_size)
+{
+    struct router_loop_port *port;
+    unsigned i;
+
+    if ((Worker_Count == 0) || (Port_Count >= ROUTER_LOOP_PORTS_MAX) ||
+        (net == 0) || (net == BACNET_BROADCAST_NETWORK) || !receive ||
+        !send || !rx_buffer || (rx_buffer_size == 0)) {
+        return -1;
+    }
+    for (i = 0; i < Port_Count; i++) {
+        if (Ports[i].net == net) {
+            return -1;
+        }
+    }
+    port = &Ports[Port_Count];
+    if (pthread_mutex_init(&port->mutex, NULL) != 0) {
+        return -1;
+    }
+    port->net = net;
+    port->fd[0] = fd;
+    port->fd[1] = fd2;
+    if (port->fd[1] == port->fd[0]) {
+        port->fd[1] = -1;
+    }
+    port->receive = receive;
+    port->send = send;
+    port->rx_buffer = rx_buffer;
+    port->rx_buffer_size = rx_buffer_size;
+    port->worker = Port_Count % Worker_Count;
+    if ((port->fd[0] < 0) && (port->fd[1] < 0)) {
+        Workers[port->worker].polled = true;
+    }
+    Port_Count++;
+
+    return (int)(Port_Count - 1);
+}
+
+/**
+ * @brief Get the number of ports in the event loop
+ * @return number of ports
+ */
+unsigned router_loop_port_count(void)
+{
+    return Port_Count;
+}
+
+/**
+ * @brief Send a PDU out one port, or out every port
+ * @param snet - network number of the port, or 0 for every port
+ * @param dest - address to where packet is sent
+ * @param npdu_data - NPCI data to control network destination
+ * @param pdu - protocol data unit to be sent
+ * @param pdu_len - number of bytes to send
+ * @return number of bytes sent, or 0 or negative on failure
+ */
+int router_loop_send_pdu(
+    uint16_t snet,
+    BACNET_ADDRESS *dest,
+    BACNET_NPDU_DATA *npdu_data,
+    uint8_t *pdu,
+    unsigned pdu_len)
+{
+    struct router_loop_port *port;
+    int bytes_sent = 0;
+    unsigned i;
+
+    for (i = 0; i < Port_Count; i++) {
+        port = &Ports[i];
+        if ((snet == 0) || (snet == port->net)) {
+            pthread_mutex_lock(&port->mutex);
+            bytes_sent = port->send(dest, npdu_data, pdu, pdu_len);
+            pthread_mutex_unlock(&port->mutex);
+            if (snet != 0) {
+                break;
+            }
+        }
+    }
+
+    return bytes_sent;
+}
+
+/**
+ * @brief Receive up to ROUTER_LOOP_BURST packets from a port,
+ *  and pass each one to the handler
+ * @param port - port to receive from
+ */
+static void router_loop_port_receive(struct router_loop_port *port)
+{
+    BACNET_ADDRESS src = { 0 };
+    uint16_t pdu_len;
+    unsigned i;
+
+    for (i = 0; i < ROUTER_LOOP_BURST; i++) {
+        pthread_mutex_lock(&port->mutex);
+        pdu_len = port->receive(&src, port->rx_buffer, port->rx_buffer_size, 0);
+        pthread_mutex_unlock(&port->mutex);
+        if (pdu_len == 0) {
+            break;
+        }
+        pthread_mutex_lock(&Dispatch_Mutex);
+        Handler(port->net, &src, port->rx_buffer, pdu_len);
+        pthread_mutex_unlock(&Dispatch_Mutex);
+    }
+}
+
+/**
+ * @brief Handle the one second timer expiration
+ */
+static void router_loop_timer(void)
+{
+    uint64_t expirations = 0;
+
+    if (read(Timer_Fd, &expirations, sizeof(expirations)) !=
+        sizeof(expirations)) {
+        return;
+    }
+    if (Timer && (expirations > 0)) {
+        pthread_mutex_lock(&Dispatch_Mutex);
+        Timer((uint32_t)expirations);
+        pthread_mutex_unlock(&Dispatch_Mutex);
+    }
+}
+
+/**
+ * @brief Wait for and handle the events of one worker until stopped
+ * @param worker - worker to run
+ */
+static void router_loop_worker_run(struct router_loop_worker *worker)
+{
+    struct epoll_event events[ROUTER_LOOP_PORTS_MAX * 2 + 2];
+    int timeout = -1;
+    int count, i;
+    unsigned p;
+    uint32_t tag;
+
+    if (worker->polled) {
+        timeout = ROUTER_LOOP_POLL_INTERVAL;
+    }
+    for (;;) {
+        count = epoll_wait(
+            worker->epoll_fd, events, sizeof(events) / sizeof(events[0]),
+            timeout);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            debug_perror("router-loop: epoll_wait");
+            return;
+        }
+        for (i = 0; i < count; i++) {
+            tag = events[i].data.u32;
+            if (tag == ROUTER_LOOP_TAG_STOP) {
+                return;
+            } else if (tag == ROUTER_LOOP_TAG_TIMER) {
+                router_loop_timer();
+            } else if (tag < Port_Count) {
+                router_loop_port_receive(&Ports[tag]);
+            }
+        }
+        if (worker->polled) {
+            for (p = 0; p < Port_Count; p++) {
+                if ((&Workers[Ports[p].worker] == worker) &&
+                    (Ports[p].fd[0] < 0) && (Ports[p].fd[1] < 0)) {
+                    router_loop_port_receive(&Ports[p]);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Worker thread entry
+ * @param arg - worker to run
+ * @return NULL
+ */
+static void *router_loop_worker_thread(void *arg)
+{
+    router_loop_worker_run((struct router_loop_worker *)arg);
+
+    return NULL;
+}
+
+/**
+ * @brief Add a descriptor to the epoll set of a worker
+ * @param worker - worker owning the descriptor
+ * @param fd - descriptor to watch for input
+ * @param tag - port index or special tag returned by epoll_wait
+ * @return true if added
+ */
+static bool
+router_loop_watch(struct router_loop_worker *worker, int fd, uint32_t tag)
+{
+    struct epoll_event event = { 0 };
+
+    event.events = EPOLLIN;
+    event.data.u32 = tag;
+
+    return epoll_ctl(worker->epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+
+/**
+ * @brief Create the epoll sets, start the worker threads, and run the
+ *  first worker in the calling thread until router_loop_stop() is called
+ * @return true if the loop ran and was stopped, false on setup failure
+ */
+bool router_loop_run(void)
+{
+    struct itimerspec interval = { 0 };
+    struct router_loop_worker *worker;
+    unsigned i, f;
+    bool status = true;
+
+    if ((Worker_Count == 0) || (Stop_Fd < 0)) {
+        return false;
+    }
+    Timer_Fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (Timer_Fd < 0) {
+        return false;
+    }
+    interval.it_interval.tv_sec = 1;
+    interval.it_value.tv_sec = 1;
+    if (timerfd_settime(Timer_Fd, 0, &interval, NULL) != 0) {
+        return false;
+    }
+    for (i = 0; i < Worker_Count; i++) {
+        worker = &Workers[i];
+        worker->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (worker->epoll_fd < 0) {
+            return false;
+        }
+        /* the stop event is never cleared, so it wakes every worker */
+        status = router_loop_watch(worker, Stop_Fd, ROUTER_LOOP_TAG_STOP);
+        if (status && (i == 0)) {
+            status = router_loop_watch(worker, Timer_Fd, ROUTER_LOOP_TAG_TIMER);
+        }
+        if (!status) {
+            return false;
+        }
+    }
+    for (i = 0; i < Port_Count; i++) {
+        for (f = 0; f < 2; f++) {
+            if (Ports[i].fd[f] < 0) {
+                continue;
+            }
+            if (!router_loop_watch(
+                    &Workers[Ports[i].worker], Ports[i].fd[f], i)) {
+                return false;
+            }
+        }
+    }
+    for (i = 1; i < Worker_Count; i++) {
+        worker = &Workers[i];
+        if (pthread_create(
+                &worker->thread, NULL, router_loop_worker_thread, worker) ==
+            0) {
+            worker->thread_started = true;
+        } else {
+            debug_perror("router-loop: pthread_create");
+            router_loop_stop();
+            status = false;
+            break;
+        }
+    }
+    if (status) {
+        router_loop_worker_run(&Workers[0]);
+    }
+    for (i = 1; i < Worker_Count; i++) {
+        worker = &Workers[i];
+        if (worker->thread_started) {
+            pthread_join(worker->thread, NULL);
+            worker->thread_started = false;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * @brief Request every worker to return from the event loop.
+ * @note Safe to call from a signal handler.
+ */
+void router_loop_stop(void)
+{
+    uint64_t value = 1;
+
+    if (Stop_Fd >= 0) {
+        (void)!write(Stop_Fd, &value, sizeof(value));
+    }
+}
+
+/**
+ * @brief Release the resources of the event loop.
+ *  The datalink descriptors are owned by the datalinks and not closed.
+ */
+void router_loop_cleanup(void)
+{
+    unsigned i;
+
+    for (i = 0; i < Worker_Count; i++) {
+        if (Workers[i].epoll_fd >= 0) {
+            close(Workers[i].epoll_fd);
+            Workers[i].epoll_fd = -1;
+        }
+    }
+    Worker_Count = 0;
+    for (i = 0; i < Port_Count; i++) {
+        pthread_mutex_destroy(&Ports[i].mutex);
+        Ports[i].rx_buffer = NULL;
+    }
+    Port_Count = 0;
+    if (Timer_Fd >= 0) {
+        close(Timer_Fd);
+        Timer_Fd = -1;
+    }
+    if (Stop_Fd >= 0) {
+        close(Stop_Fd);
+        Stop_Fd = -1;
+    }
+    Handler = NULL;
+    Timer = NULL;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file
+ * @brief API for an epoll event loop that receives from many BACnet
+ *  datalinks and hands each NPDU to a routing handler.
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2026
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#ifndef BACNET_PORT_LINUX_ROUTER_LOOP_H
+#define BACNET_PORT_LINUX_ROUTER_LOOP_H
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+/* BACnet Stack defines - first */
+#include "bacnet/bacdef.h"
+/* BACnet Stack API */
+#include "bacnet/npdu.h"
+
+/* maximum number of datalink ports served by the loop */
+#ifndef ROUTER_LOOP_PORTS_MAX
+#define ROUTER_LOOP_PORTS_MAX 16
+#endif
+/* maximum number of worker threads the ports are sharded across */
+#ifndef ROUTER_LOOP_WORKERS_MAX
+#define ROUTER_LOOP_WORKERS_MAX 8
+#endif
+/* maximum number of packets taken from one port per wake-up,
+   so that a busy port can not starve the other ports */
+#ifndef ROUTER_LOOP_BURST
+#define ROUTER_LOOP_BURST 8
+#endif
+/* milliseconds between receive calls for ports without a descriptor */
+#ifndef ROUTER_LOOP_POLL_INTERVAL
+#define ROUTER_LOOP_POLL_INTERVAL 5
+#endif
+
+/* same signature as bip_receive(), bip6_receive(), dlmstp_receive()
+   and bsc_receive() */
+typedef uint16_t (*router_loop_receive_function)(
+    BACNET_ADDRESS *src, uint8_t *pdu, uint16_t max_pdu, unsigned timeout);
+/* same signature as bip_send_pdu(), bip6_send_pdu(), dlmstp_send_pdu()
+   and bsc_send_pdu() */
+typedef int (*router_loop_send_function)(
+    BACNET_ADDRESS *dest,
+    BACNET_NPDU_DATA *npdu_data,
+    uint8_t *pdu,
+    unsigned pdu_len);
+/* called with each received NPDU and the network number of the port */
+typedef void (*router_loop_handler_function)(
+    uint16_t snet, BACNET_ADDRESS *src, uint8_t *pdu, uint16_t pdu_len);
+/* called about once per second with the number of elapsed seconds */
+typedef void (*router_loop_timer_function)(uint32_t elapsed_seconds);
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+BACNET_STACK_EXPORT
+bool router_loop_init(
+    unsigned workers,
+    router_loop_handler_function handler,
+    router_loop_timer_function timer);
+BACNET_STACK_EXPORT
+int router_loop_port_add(
+    uint16_t net,
+    int fd,
+    int fd2,
+    router_loop_receive_function receive,
+    router_loop_send_function send,
+    uint8_t *rx_buffer,
+    uint16_t rx_buffer_size);
+BACNET_STACK_EXPORT
+unsigned router_loop_port_count(void);
+BACNET_STACK_EXPORT
+int router_loop_send_pdu(
+    uint16_t snet,
+    BACNET_ADDRESS *dest,
+    BACNET_NPDU_DATA *npdu_data,
+    uint8_t *pdu,
+    unsigned pdu_len);
+BACNET_STACK_EXPORT
+bool router_loop_run(void);
+BACNET_STACK_EXPORT
+void router_loop_stop(void);
+BACNET_STACK_EXPORT
+void router_loop_cleanup(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
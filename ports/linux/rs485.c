@@ -293,6 +293,55 @@ void RS485_Check_UART_Data(struct mstp_port_struct_t *mstp_port)
     }
 }
 
+/****************************************************************************
+ * DESCRIPTION: Receive the waiting bytes with the receive state machine
+ * RETURN:      none
+ * ALGORITHM:   the bytes in the FIFO are given to the receive state machine
+ *              as a block, and any bytes left over after a frame stay in
+ *              the FIFO until the frame has been handled.
+ * NOTES:       Replaces RS485_Check_UART_Data() and MSTP_Receive_Frame_FSM()
+ *****************************************************************************/
+void RS485_Receive_Frame_Data(struct mstp_port_struct_t *mstp_port)
+{
+    fd_set input;
+    struct timeval waiter;
+    uint8_t buf[2048];
+    ssize_t n;
+    unsigned count;
+    size_t used;
+    int handle = RS485_Handle;
+    SHARED_MSTP_DATA *poSharedData;
+    FIFO_BUFFER *fifo = &Rx_FIFO;
+
+    poSharedData = (SHARED_MSTP_DATA *)mstp_port->UserData;
+    if (poSharedData) {
+        handle = poSharedData->RS485_Handle;
+        fifo = &poSharedData->Rx_FIFO;
+    }
+    if (FIFO_Empty(fifo)) {
+        /* wait for some bytes to arrive */
+        waiter.tv_sec = 0;
+        waiter.tv_usec = 5000;
+        FD_ZERO(&input);
+        FD_SET(handle, &input);
+        n = select(handle + 1, &input, NULL, NULL, &waiter);
+        if ((n > 0) && FD_ISSET(handle, &input)) {
+            n = read(handle, buf, sizeof(buf));
+            if (n > 0) {
+                FIFO_Add(fifo, &buf[0], n);
+            }
+        }
+    }
+    count = FIFO_Peek_Ahead(fifo, buf, sizeof(buf));
+    if (count > 0) {
+        used = MSTP_Receive_Frame_Buffer(mstp_port, buf, count);
+        (void)FIFO_Pull(fifo, NULL, (unsigned)used);
+    } else {
+        /* no data - let the state machine check for timeouts */
+        MSTP_Receive_Frame_FSM(mstp_port);
+    }
+}
+
 void RS485_Cleanup(void)
 {
     /* restore the old port settings */
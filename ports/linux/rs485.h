@@ -35,6 +35,9 @@ BACNET_STACK_EXPORT
 void RS485_Check_UART_Data(
     struct mstp_port_struct_t *mstp_port); /* port specific data */
 BACNET_STACK_EXPORT
+void RS485_Receive_Frame_Data(
+    struct mstp_port_struct_t *mstp_port); /* port specific data */
+BACNET_STACK_EXPORT
 uint32_t RS485_Get_Port_Baud_Rate(struct mstp_port_struct_t *mstp_port);
 BACNET_STACK_EXPORT
 uint32_t RS485_Get_Baud_Rate(void);
@@ -80,6 +80,15 @@ static LPSTR PrintError(int ErrorCode)
     return Message;
 }
 
+/**
+ * @brief Return the active BIP6 socket.
+ * @return The active BIP6 socket, or -1 if uninitialized.
+ */
+int bip6_get_socket(void)
+{
+    return (int)BIP6_Socket;
+}
+
 /* on Windows, ifname is the IPv6 address of the interface */
 void bip6_set_interface(const char *ifname)
 {
@@ -0,0 +1,595 @@
+/**
+ * @file
+ * @brief A compact BACnet application data value that stores scalars
+ *  inline and references variable length data in the source APDU or in
+ *  an arena, for clients that cache many property values.
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2026
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+/* BACnet Stack defines - first */
+#include "bacnet/bacdef.h"
+/* BACnet Stack API */
+#include "bacnet/bacdcode.h"
+#include "bacnet/bacstr.h"
+#include "bacnet/bacapp_compact.h"
+
+/* the largest encoding of an inline scalar: tag, length, and value */
+#define BACAPP_COMPACT_SCALAR_SIZE 16
+
+/**
+ * @brief Decode one application tagged primitive value, or keep a
+ *  reference to one context tagged or constructed value, without copying
+ *  any data out of the APDU.
+ * @param apdu - buffer of data to be decoded
+ * @param apdu_size - number of bytes in the buffer
+ * @param value - compact value that references the buffer
+ * @return number of bytes decoded, or BACNET_STATUS_ERROR
+ */
+int bacapp_compact_decode(
+    const uint8_t *apdu, size_t apdu_size, BACNET_COMPACT_VALUE *value)
+{
+    BACNET_TAG tag = { 0 };
+    BACNET_OBJECT_TYPE object_type = OBJECT_NONE;
+    uint32_t size, len_value;
+    int tag_len, len = 0;
+
+    if (!apdu || !value || (apdu_size == 0)) {
+        return BACNET_STATUS_ERROR;
+    }
+    size = (apdu_size > UINT32_MAX) ? UINT32_MAX : (uint32_t)apdu_size;
+    tag_len = bacnet_tag_decode(apdu, size, &tag);
+    if (tag_len <= 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    memset(value, 0, sizeof(*value));
+    if (tag.opening || tag.context) {
+        if (tag.opening) {
+            /* constructed: keep the opening and closing tags */
+            len = bacnet_enclosed_data_length(apdu, size);
+            if (len < 0) {
+                return BACNET_STATUS_ERROR;
+            }
+            len += tag_len + tag_len;
+        } else if (tag.len_value_type <= (size - tag_len)) {
+            len = tag_len + (int)tag.len_value_type;
+        } else {
+            return BACNET_STATUS_ERROR;
+        }
+        if ((uint32_t)len > size) {
+            return BACNET_STATUS_ERROR;
+        }
+        value->tag = BACNET_APPLICATION_TAG_ABSTRACT_SYNTAX;
+        value->context_specific = true;
+        value->context_tag = tag.number;
+        value->length = (uint32_t)len;
+        value->type.Data = apdu;
+        return len;
+    }
+    if (!tag.application || tag.closing) {
+        return BACNET_STATUS_ERROR;
+    }
+    value->tag = tag.number;
+    len_value = tag.len_value_type;
+    apdu += tag_len;
+    size -= tag_len;
+    if ((tag.number != BACNET_APPLICATION_TAG_BOOLEAN) && (len_value > size)) {
+        return BACNET_STATUS_ERROR;
+    }
+    switch (tag.number) {
+        case BACNET_APPLICATION_TAG_NULL:
+            break;
+        case BACNET_APPLICATION_TAG_BOOLEAN:
+            /* the value is encoded in the tag alone */
+            value->type.Boolean = decode_boolean(len_value);
+            break;
+        case BACNET_APPLICATION_TAG_UNSIGNED_INT:
+            len = bacnet_unsigned_decode(
+                apdu, size, len_value, &value->type.Unsigned_Int);
+            break;
+        case BACNET_APPLICATION_TAG_SIGNED_INT:
+            len = bacnet_signed_decode(
+                apdu, size, len_value, &value->type.Signed_Int);
+            break;
+        case BACNET_APPLICATION_TAG_REAL:
+            len = bacnet_real_decode(apdu, size, len_value, &value->type.Real);
+            break;
+        case BACNET_APPLICATION_TAG_DOUBLE:
+            len = bacnet_double_decode(
+                apdu, size, len_value, &value->type.Double);
+            break;
+        case BACNET_APPLICATION_TAG_ENUMERATED:
+            len = bacnet_enumerated_decode(
+                apdu, size, len_value, &value->type.Enumerated);
+            break;
+        case BACNET_APPLICATION_TAG_DATE:
+            len = bacnet_date_decode(apdu, size, len_value, &value->type.Date);
+            break;
+        case BACNET_APPLICATION_TAG_TIME:
+            len = bacnet_time_decode(apdu, size, len_value, &value->type.Time);
+            break;
+        case BACNET_APPLICATION_TAG_OBJECT_ID:
+            len = bacnet_object_id_decode(
+                apdu, size, len_value, &object_type,
+                &value->type.Object_Id.instance);
+            value->type.Object_Id.type = object_type;
+            break;
+        case BACNET_APPLICATION_TAG_OCTET_STRING:
+            value->length = len_value;
+            value->type.Data = apdu;
+            len = (int)len_value;
+            break;
+        case BACNET_APPLICATION_TAG_CHARACTER_STRING:
+            /* the character set octet is followed by the characters */
+            if (len_value == 0) {
+                return BACNET_STATUS_ERROR;
+            }
+            value->encoding = apdu[0];
+            value->length = len_value - 1;
+            value->type.Data = &apdu[1];
+            len = (int)len_value;
+            break;
+        case BACNET_APPLICATION_TAG_BIT_STRING:
+            /* keep the unused bits octet with the bits */
+            if (len_value == 0) {
+                return BACNET_STATUS_ERROR;
+            }
+            value->encoding = apdu[0];
+            value->length = len_value;
+            value->type.Data = apdu;
+            len = (int)len_value;
+            break;
+        default:
+            return BACNET_STATUS_ERROR;
+    }
+    if ((tag.number != BACNET_APPLICATION_TAG_BOOLEAN) &&
+        (len != (int)len_value)) {
+        /* the value is malformed */
+        return BACNET_STATUS_ERROR;
+    }
+
+    return tag_len + len;
+}
+
+/**
+ * @brief Decode one property value into a compact value. Properties with
+ *  a complex datatype keep a reference to their complete encoding.
+ * @param apdu - buffer of data to be decoded
+ * @param apdu_size - number of bytes in the buffer
+ * @param value - compact value that references the buffer
+ * @param object_type - object type of the property
+ * @param property - property identifier
+ * @return number of bytes decoded, or BACNET_STATUS_ERROR
+ */
+int bacapp_compact_decode_known_property(
+    const uint8_t *apdu,
+    size_t apdu_size,
+    BACNET_COMPACT_VALUE *value,
+    BACNET_OBJECT_TYPE object_type,
+    BACNET_PROPERTY_ID property)
+{
+    BACNET_APPLICATION_DATA_VALUE scratch;
+    int known_tag, len;
+
+    if (!apdu || !value || (apdu_size == 0)) {
+        return BACNET_STATUS_ERROR;
+    }
+    known_tag = bacapp_known_property_tag(object_type, property);
+    if (known_tag < MAX_BACNET_APPLICATION_TAG) {
+        return bacapp_compact_decode(apdu, apdu_size, value);
+    }
+    /* the complex value is decoded once to find its length */
+    if (apdu_size > INT_MAX) {
+        apdu_size = INT_MAX;
+    }
+    len = bacapp_decode_known_property(
+        apdu, (int)apdu_size, &scratch, object_type, property);
+    if (len <= 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    memset(value, 0, sizeof(*value));
+    value->tag = (uint8_t)known_tag;
+    value->length = (uint32_t)len;
+    value->type.Data = apdu;
+
+    return len;
+}
+
+/**
+ * @brief Encode a compact value
+ * @param apdu - buffer to hold the encoding, or NULL for length only
+ * @param value - compact value to encode
+ * @return number of bytes encoded, or 0 if the value is not valid
+ */
+int bacapp_compact_encode(uint8_t *apdu, const BACNET_COMPACT_VALUE *value)
+{
+    int len = 0;
+
+    if (!value) {
+        return 0;
+    }
+    if (value->tag >= MAX_BACNET_APPLICATION_TAG) {
+        /* complex or context tagged values are kept encoded */
+        if (value->length && !value->type.Data) {
+            return 0;
+        }
+        if (apdu && value->length) {
+            memcpy(apdu, value->type.Data, value->length);
+        }
+        return (int)value->length;
+    }
+    switch (value->tag) {
+        case BACNET_APPLICATION_TAG_NULL:
+            len = encode_application_null(apdu);
+            break;
+        case BACNET_APPLICATION_TAG_BOOLEAN:
+            len = encode_application_boolean(apdu, value->type.Boolean);
+            break;
+        case BACNET_APPLICATION_TAG_UNSIGNED_INT:
+            len = encode_application_unsigned(apdu, value->type.Unsigned_Int);
+            break;
+        case BACNET_APPLICATION_TAG_SIGNED_INT:
+            len = encode_application_signed(apdu, value->type.Signed_Int);
+            break;
+        case BACNET_APPLICATION_TAG_REAL:
+            len = encode_application_real(apdu, value->type.Real);
+            break;
+        case BACNET_APPLICATION_TAG_DOUBLE:
+            len = encode_application_double(apdu, value->type.Double);
+            break;
+        case BACNET_APPLICATION_TAG_ENUMERATED:
+            len = encode_application_enumerated(apdu, value->type.Enumerated);
+            break;
+        case BACNET_APPLICATION_TAG_DATE:
+            len = encode_application_date(apdu, &value->type.Date);
+            break;
+        case BACNET_APPLICATION_TAG_TIME:
+            len = encode_application_time(apdu, &value->type.Time);
+            break;
+        case BACNET_APPLICATION_TAG_OBJECT_ID:
+            len = encode_application_object_id(
+                apdu, value->type.Object_Id.type,
+                value->type.Object_Id.instance);
+            break;
+        case BACNET_APPLICATION_TAG_OCTET_STRING:
+        case BACNET_APPLICATION_TAG_BIT_STRING:
+            if (value->length && !value->type.Data) {
+                return 0;
+            }
+            len = encode_tag(apdu, value->tag, false, value->length);
+            if (apdu && value->length) {
+                memcpy(&apdu[len], value->type.Data, value->length);
+            }
+            len += (int)value->length;
+            break;
+        case BACNET_APPLICATION_TAG_CHARACTER_STRING:
+            if (value->length && !value->type.Data) {
+                return 0;
+            }
+            len = encode_tag(apdu, value->tag, false, value->length + 1);
+            if (apdu) {
+                apdu[len] = value->encoding;
+                if (value->length) {
+                    memcpy(&apdu[len + 1], value->type.Data, value->length);
+                }
+            }
+            len += 1 + (int)value->length;
+            break;
+        default:
+            break;
+    }
+
+    return len;
+}
+
+/**
+ * @brief Expand a compact value into an application data value
+ * @param compact - compact value
+ * @param value - application data value to fill
+ * @param object_type - object type of the property, for complex values
+ * @param property - property identifier, for complex values
+ * @return true if the value was expanded
+ */
+bool bacapp_compact_to_value(
+    const BACNET_COMPACT_VALUE *compact,
+    BACNET_APPLICATION_DATA_VALUE *value,
+    BACNET_OBJECT_TYPE object_type,
+    BACNET_PROPERTY_ID property)
+{
+    uint8_t apdu[BACAPP_COMPACT_SCALAR_SIZE];
+    int len;
+
+    if (!compact || !value) {
+        return false;
+    }
+    if (compact->length && !compact->type.Data) {
+        return false;
+    }
+    if (compact->tag == BACNET_APPLICATION_TAG_ABSTRACT_SYNTAX) {
+        /* the datatype of a context tagged value is not known here */
+        return false;
+    }
+    if (compact->tag >= MAX_BACNET_APPLICATION_TAG) {
+        len = bacapp_decode_known_property(
+            compact->type.Data, (int)compact->length, value, object_type,
+            property);
+        return (len > 0);
+    }
+    bacapp_value_list_init(value, 1);
+    value->tag = compact->tag;
+    switch (compact->tag) {
+        case BACNET_APPLICATION_TAG_OCTET_STRING:
+#if defined(BACAPP_OCTET_STRING)
+            return octetstring_init(
+                &value->type.Octet_String, compact->type.Data,
+                compact->length);
+#else
+            return false;
+#endif
+        case BACNET_APPLICATION_TAG_CHARACTER_STRING:
+#if defined(BACAPP_CHARACTER_STRING)
+            return characterstring_init(
+                &value->type.Character_String, compact->encoding,
+                (const char *)compact->type.Data, compact->length);
+#else
+            return false;
+#endif
+        case BACNET_APPLICATION_TAG_BIT_STRING:
+#if defined(BACAPP_BIT_STRING)
+            len = bacnet_bitstring_decode(
+                compact->type.Data, compact->length, compact->length,
+                &value->type.Bit_String);
+            return (len > 0);
+#else
+            return false;
+#endif
+        default:
+            break;
+    }
+    /* scalars are expanded through their encoding, which honors
+       the BACAPP datatypes enabled in this build */
+    len = bacapp_compact_encode(apdu, compact);
+    if (len <= 0) {
+        return false;
+    }
+    len = bacapp_decode_application_data(apdu, (uint32_t)len, value);
+
+    return (len > 0);
+}
+
+/**
+ * @brief Compact an application data value. Variable length data
+ *  is copied into the arena.
+ * @param compact - compact value to fill
+ * @param value - application data value
+ * @param arena - arena for variable length data, or NULL if the
+ *  value holds only a scalar
+ * @return true if the value was compacted
+ */
+bool bacapp_compact_from_value(
+    BACNET_COMPACT_VALUE *compact,
+    const BACNET_APPLICATION_DATA_VALUE *value,
+    BACNET_COMPACT_ARENA *arena)
+{
+    uint8_t apdu[BACAPP_COMPACT_SCALAR_SIZE];
+    uint8_t *buffer;
+    int len;
+
+    if (!compact || !value) {
+        return false;
+    }
+    len = bacapp_encode_data(NULL, value);
+    if (len <= 0) {
+        return false;
+    }
+    if (!value->context_specific && (value->tag < MAX_BACNET_APPLICATION_TAG) &&
+        (value->tag != BACNET_APPLICATION_TAG_OCTET_STRING) &&
+        (value->tag != BACNET_APPLICATION_TAG_CHARACTER_STRING) &&
+        (value->tag != BACNET_APPLICATION_TAG_BIT_STRING)) {
+        if ((size_t)len > sizeof(apdu)) {
+            return false;
+        }
+        len = bacapp_encode_data(apdu, value);
+        return (bacapp_compact_decode(apdu, (size_t)len, compact) > 0);
+    }
+    if (!arena || (bacapp_compact_arena_free(arena) < (size_t)len)) {
+        return false;
+    }
+    buffer = &arena->buffer[arena->used];
+    len = bacapp_encode_data(buffer, value);
+    arena->used += (size_t)len;
+    if (value->context_specific || (value->tag >= MAX_BACNET_APPLICATION_TAG)) {
+        memset(compact, 0, sizeof(*compact));
+        if (value->context_specific) {
+            compact->tag = BACNET_APPLICATION_TAG_ABSTRACT_SYNTAX;
+            compact->context_specific = true;
+            compact->context_tag = value->context_tag;
+        } else {
+            compact->tag = value->tag;
+        }
+        compact->length = (uint32_t)len;
+        compact->type.Data = buffer;
+        return true;
+    }
+
+    return (bacapp_compact_decode(buffer, (size_t)len, compact) > 0);
+}
+
+/**
+ * @brief Compare two compact values
+ * @param value1 - compact value
+ * @param value2 - compact value
+ * @return true if the datatypes and the values are the same
+ */
+bool bacapp_compact_same(
+    const BACNET_COMPACT_VALUE *value1, const BACNET_COMPACT_VALUE *value2)
+{
+    uint8_t apdu1[BACAPP_COMPACT_SCALAR_SIZE];
+    uint8_t apdu2[BACAPP_COMPACT_SCALAR_SIZE];
+    int len1, len2;
+
+    if (!value1 || !value2) {
+        return false;
+    }
+    if ((value1->tag != value2->tag) ||
+        (value1->context_specific != value2->context_specific) ||
+        (value1->context_tag != value2->context_tag) ||
+        (value1->encoding != value2->encoding) ||
+        (value1->length != value2->length)) {
+        return false;
+    }
+    if ((value1->tag >= MAX_BACNET_APPLICATION_TAG) ||
+        (value1->tag == BACNET_APPLICATION_TAG_OCTET_STRING) ||
+        (value1->tag == BACNET_APPLICATION_TAG_CHARACTER_STRING) ||
+        (value1->tag == BACNET_APPLICATION_TAG_BIT_STRING)) {
+        if (value1->length == 0) {
+            return true;
+        }
+        if (!value1->type.Data || !value2->type.Data) {
+            return false;
+        }
+        return (
+            memcmp(value1->type.Data, value2->type.Data, value1->length) ==
+            0);
+    }
+    /* compare scalars by their encoding, so that union padding
+       and the bits of unused members never matter */
+    len1 = bacapp_compact_encode(apdu1, value1);
+    len2 = bacapp_compact_encode(apdu2, value2);
+
+    return (len1 == len2) && (len1 > 0) && (memcmp(apdu1, apdu2, len1) == 0);
+}
+
+/**
+ * @brief Print a compact value to a string, in the same format as
+ *  bacapp_snprintf_value()
+ * @param str - destination string, or NULL for length only
+ * @param str_len - length of the destination string, or 0 for length only
+ * @param value - compact value to print
+ * @param object_type - object type of the property
+ * @param property - property identifier
+ * @return number of characters written
+ */
+int bacapp_compact_snprintf(
+    char *str,
+    size_t str_len,
+    const BACNET_COMPACT_VALUE *value,
+    BACNET_OBJECT_TYPE object_type,
+    BACNET_PROPERTY_ID property)
+{
+    BACNET_APPLICATION_DATA_VALUE app_value;
+    BACNET_OBJECT_PROPERTY_VALUE object_value = { 0 };
+    int ret_val = 0;
+    int slen;
+    uint32_t i;
+
+    if (!value) {
+        return 0;
+    }
+    if (bacapp_compact_to_value(value, &app_value, object_type, property)) {
+        object_value.object_type = object_type;
+        object_value.object_instance = 0;
+        object_value.object_property = property;
+        object_value.array_index = BACNET_ARRAY_ALL;
+        object_value.value = &app_value;
+        return bacapp_snprintf_value(str, str_len, &object_value);
+    }
+    /* unknown datatypes are printed as their encoding */
+    slen = bacapp_snprintf(str, str_len, "X'");
+    ret_val += bacapp_snprintf_shift(slen, &str, &str_len);
+    if (value->type.Data) {
+        for (i = 0; i < value->length; i++) {
+            slen = bacapp_snprintf(str, str_len, "%02X", value->type.Data[i]);
+            ret_val += bacapp_snprintf_shift(slen, &str, &str_len);
+        }
+    }
+    slen = bacapp_snprintf(str, str_len, "'");
+    ret_val += slen;
+
+    return ret_val;
+}
+
+/**
+ * @brief Initialize an arena for compact value data
+ * @param arena - arena to initialize
+ * @param buffer - storage for the arena
+ * @param size - number of bytes of storage
+ */
+void bacapp_compact_arena_init(
+    BACNET_COMPACT_ARENA *arena, uint8_t *buffer, size_t size)
+{
+    if (arena) {
+        arena->buffer = buffer;
+        arena->size = buffer ? size : 0;
+        arena->used = 0;
+    }
+}
+
+/**
+ * @brief Release all of the data in an arena at once
+ * @param arena - arena to reset
+ * @note compact values that reference the arena are no longer valid
+ */
+void bacapp_compact_arena_reset(BACNET_COMPACT_ARENA *arena)
+{
+    if (arena) {
+        arena->used = 0;
+    }
+}
+
+/**
+ * @brief Get the number of bytes left in an arena
+ * @param arena - arena
+ * @return number of bytes left
+ */
+size_t bacapp_compact_arena_free(const BACNET_COMPACT_ARENA *arena)
+{
+    if (!arena || (arena->used > arena->size)) {
+        return 0;
+    }
+
+    return arena->size - arena->used;
+}
+
+/**
+ * @brief Copy the data referenced by a compact value into an arena,
+ *  so that the value no longer depends on the APDU it was decoded from
+ * @param arena - arena to hold the data
+ * @param value - compact value to update
+ * @return true if the value holds no referenced data or the data
+ *  was copied, false if the arena is full
+ */
+bool bacapp_compact_arena_store(
+    BACNET_COMPACT_ARENA *arena, BACNET_COMPACT_VALUE *value)
+{
+    uint8_t *buffer;
+
+    if (!value) {
+        return false;
+    }
+    if ((value->tag < MAX_BACNET_APPLICATION_TAG) &&
+        (value->tag != BACNET_APPLICATION_TAG_OCTET_STRING) &&
+        (value->tag != BACNET_APPLICATION_TAG_CHARACTER_STRING) &&
+        (value->tag != BACNET_APPLICATION_TAG_BIT_STRING)) {
+        /* scalars are stored inline */
+        return true;
+    }
+    if (value->length == 0) {
+        return true;
+    }
+    if (!value->type.Data ||
+        (bacapp_compact_arena_free(arena) < value->length)) {
+        return false;
+    }
+    buffer = &arena->buffer[arena->used];
+    memcpy(buffer, value->type.Data, value->length);
+    arena->used += value->length;
+    value->type.Data = buffer;
+
+    return true;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file
+ * @brief API for a compact BACnet application data value that stores
+ *  scalars inline and references variable length data in the source
+ *  APDU or in an arena, for clients that cache many property values.
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2026
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#ifndef BACNET_APP_COMPACT_H
+#define BACNET_APP_COMPACT_H
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+/* BACnet Stack defines - first */
+#include "bacnet/bacdef.h"
+/* BACnet Stack API */
+#include "bacnet/bacenum.h"
+#include "bacnet/bacapp.h"
+#include "bacnet/datetime.h"
+
+/**
+ * A compact application data value.
+ *
+ * Primitive values that fit in eight octets are stored inline.
+ * Octet, character and bit strings reference their contents, and
+ * complex or context tagged values reference their complete encoding
+ * (tags included), either in the APDU they were decoded from or in
+ * an arena. The referenced data must outlive the value.
+ */
+typedef struct BACnet_Compact_Value {
+    uint8_t tag; /* BACNET_APPLICATION_TAG data type */
+    uint8_t context_tag; /* only used for context specific data */
+    bool context_specific : 1; /* true if context specific data */
+    /* character set of a character string,
+       or the number of unused bits of a bit string */
+    uint8_t encoding;
+    /* number of octets referenced by type.Data */
+    uint32_t length;
+    union {
+        bool Boolean;
+        BACNET_UNSIGNED_INTEGER Unsigned_Int;
+        int32_t Signed_Int;
+        float Real;
+        double Double;
+        uint32_t Enumerated;
+        BACNET_DATE Date;
+        BACNET_TIME Time;
+        BACNET_OBJECT_ID Object_Id;
+        const uint8_t *Data;
+    } type;
+} BACNET_COMPACT_VALUE;
+
+/**
+ * A bump allocator that holds the variable length data referenced
+ * by compact values once the source APDU is gone.
+ */
+typedef struct BACnet_Compact_Arena {
+    uint8_t *buffer;
+    size_t size;
+    size_t used;
+} BACNET_COMPACT_ARENA;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+BACNET_STACK_EXPORT
+int bacapp_compact_decode(
+    const uint8_t *apdu, size_t apdu_size, BACNET_COMPACT_VALUE *value);
+BACNET_STACK_EXPORT
+int bacapp_compact_decode_known_property(
+    const uint8_t *apdu,
+    size_t apdu_size,
+    BACNET_COMPACT_VALUE *value,
+    BACNET_OBJECT_TYPE object_type,
+    BACNET_PROPERTY_ID property);
+BACNET_STACK_EXPORT
+int bacapp_compact_encode(uint8_t *apdu, const BACNET_COMPACT_VALUE *value);
+
+BACNET_STACK_EXPORT
+bool bacapp_compact_to_value(
+    const BACNET_COMPACT_VALUE *compact,
+    BACNET_APPLICATION_DATA_VALUE *value,
+    BACNET_OBJECT_TYPE object_type,
+    BACNET_PROPERTY_ID property);
+BACNET_STACK_EXPORT
+bool bacapp_compact_from_value(
+    BACNET_COMPACT_VALUE *compact,
+    const BACNET_APPLICATION_DATA_VALUE *value,
+    BACNET_COMPACT_ARENA *arena);
+BACNET_STACK_EXPORT
+bool bacapp_compact_same(
+    const BACNET_COMPACT_VALUE *value1, const BACNET_COMPACT_VALUE *value2);
+
+BACNET_STACK_EXPORT
+int bacapp_compact_snprintf(
+    char *str,
+    size_t str_len,
+    const BACNET_COMPACT_VALUE *value,
+    BACNET_OBJECT_TYPE object_type,
+    BACNET_PROPERTY_ID property);
+
+BACNET_STACK_EXPORT
+void bacapp_compact_arena_init(
+    BACNET_COMPACT_ARENA *arena, uint8_t *buffer, size_t size);
+BACNET_STACK_EXPORT
+void bacapp_compact_arena_reset(BACNET_COMPACT_ARENA *arena);
+BACNET_STACK_EXPORT
+size_t bacapp_compact_arena_free(const BACNET_COMPACT_ARENA *arena);
+BACNET_STACK_EXPORT
+bool bacapp_compact_arena_store(
+    BACNET_COMPACT_ARENA *arena, BACNET_COMPACT_VALUE *value);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
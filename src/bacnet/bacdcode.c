@@ -910,6 +910,593 @@ int bacnet_enclosed_data_length(const uint8_t *apdu, size_t apdu_size)
     return total_len;
 }
 
+/**
+ * @brief Initialize a reader that walks the tags of an encoded buffer
+ *  in place, decoding values only when they are asked for.
+ * @param reader - reader to initialize
+ * @param apdu - buffer of encoded data, which must outlive the reader
+ * @param apdu_size - number of valid bytes in the buffer
+ */
+void bacnet_reader_init(
+    BACNET_READER *reader, const uint8_t *apdu, uint32_t apdu_size)
+{
+    if (reader) {
+        reader->apdu = apdu;
+        reader->apdu_size = apdu ? apdu_size : 0;
+        reader->offset = 0;
+        reader->tag_len = 0;
+        reader->data_len = 0;
+        reader->error = false;
+    }
+}
+
+/**
+ * @brief Move the reader forward, forgetting the tag at the cursor
+ * @param reader - reader to advance
+ * @param len - number of bytes to move forward
+ */
+static void bacnet_reader_consume(BACNET_READER *reader, uint32_t len)
+{
+    reader->offset += len;
+    reader->tag_len = 0;
+    reader->data_len = 0;
+}
+
+/**
+ * @brief Decode the tag at the reader cursor without consuming it.
+ *  The tag is decoded once and kept until the cursor moves.
+ * @param reader - reader to use
+ * @return the tag at the cursor, or NULL at the end of the buffer
+ *  or on a malformed tag (which also sets the reader error)
+ */
+const BACNET_TAG *bacnet_reader_peek(BACNET_READER *reader)
+{
+    int len;
+    uint32_t remaining;
+    uint32_t data_len = 0;
+
+    if (!reader || reader->error) {
+        return NULL;
+    }
+    if (reader->tag_len > 0) {
+        return &reader->tag;
+    }
+    remaining = reader->apdu_size - reader->offset;
+    if (remaining == 0) {
+        return NULL;
+    }
+    len = bacnet_tag_decode(
+        &reader->apdu[reader->offset], remaining, &reader->tag);
+    if (len <= 0) {
+        reader->error = true;
+        return NULL;
+    }
+    if (reader->tag.opening || reader->tag.closing) {
+        data_len = 0;
+    } else if (reader->tag.context) {
+        data_len = reader->tag.len_value_type;
+    } else {
+        data_len = (uint32_t)bacnet_application_data_length(
+            reader->tag.number, reader->tag.len_value_type);
+    }
+    if (data_len > (remaining - (uint32_t)len)) {
+        /* error: the tagged data does not fit in the buffer */
+        reader->error = true;
+        return NULL;
+    }
+    reader->tag_len = (uint8_t)len;
+    reader->data_len = data_len;
+
+    return &reader->tag;
+}
+
+/**
+ * @brief Get the number of bytes consumed by the reader so far
+ * @param reader - reader to use
+ * @return number of bytes from the start of the buffer to the cursor
+ */
+uint32_t bacnet_reader_offset(const BACNET_READER *reader)
+{
+    return reader ? reader->offset : 0;
+}
+
+/**
+ * @brief Get the number of bytes left after the reader cursor
+ * @param reader - reader to use
+ * @return number of bytes from the cursor to the end of the buffer
+ */
+uint32_t bacnet_reader_remaining(const BACNET_READER *reader)
+{
+    return reader ? (reader->apdu_size - reader->offset) : 0;
+}
+
+/**
+ * @brief Get the encoded data at the reader cursor, to hand off to
+ *  a decoder that works on a buffer. Use bacnet_reader_advance()
+ *  with the length that the decoder consumed.
+ * @param reader - reader to use
+ * @return pointer to the buffer at the cursor, or NULL
+ */
+const uint8_t *bacnet_reader_data(const BACNET_READER *reader)
+{
+    if (!reader || !reader->apdu) {
+        return NULL;
+    }
+
+    return &reader->apdu[reader->offset];
+}
+
+/**
+ * @brief Determine if the reader has found malformed data
+ * @param reader - reader to use
+ * @return true if the reader found malformed data
+ */
+bool bacnet_reader_error(const BACNET_READER *reader)
+{
+    return reader ? reader->error : true;
+}
+
+/**
+ * @brief Move the reader cursor forward by a number of bytes
+ * @param reader - reader to use
+ * @param len - number of bytes to move forward
+ * @return true if the bytes were within the buffer
+ */
+bool bacnet_reader_advance(BACNET_READER *reader, uint32_t len)
+{
+    if (!reader || reader->error) {
+        return false;
+    }
+    if (len > bacnet_reader_remaining(reader)) {
+        reader->error = true;
+        return false;
+    }
+    bacnet_reader_consume(reader, len);
+
+    return true;
+}
+
+/**
+ * @brief Determine if the reader cursor is at a specific opening tag
+ * @param reader - reader to use
+ * @param tag_number - context tag number to match
+ * @return true if the cursor is at the opening tag
+ */
+bool bacnet_reader_is_opening(BACNET_READER *reader, uint8_t tag_number)
+{
+    const BACNET_TAG *tag = bacnet_reader_peek(reader);
+
+    return tag && tag->opening && (tag->number == tag_number);
+}
+
+/**
+ * @brief Determine if the reader cursor is at a specific closing tag
+ * @param reader - reader to use
+ * @param tag_number - context tag number to match
+ * @return true if the cursor is at the closing tag
+ */
+bool bacnet_reader_is_closing(BACNET_READER *reader, uint8_t tag_number)
+{
+    const BACNET_TAG *tag = bacnet_reader_peek(reader);
+
+    return tag && tag->closing && (tag->number == tag_number);
+}
+
+/**
+ * @brief Consume a specific opening tag at the reader cursor
+ * @param reader - reader to use
+ * @param tag_number - context tag number to match
+ * @return true if the opening tag was consumed
+ */
+bool bacnet_reader_opening(BACNET_READER *reader, uint8_t tag_number)
+{
+    if (bacnet_reader_is_opening(reader, tag_number)) {
+        bacnet_reader_consume(reader, reader->tag_len);
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Consume a specific closing tag at the reader cursor
+ * @param reader - reader to use
+ * @param tag_number - context tag number to match
+ * @return true if the closing tag was consumed
+ */
+bool bacnet_reader_closing(BACNET_READER *reader, uint8_t tag_number)
+{
+    if (bacnet_reader_is_closing(reader, tag_number)) {
+        bacnet_reader_consume(reader, reader->tag_len);
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Skip the element at the reader cursor in a single pass:
+ *  a primitive value, or a constructed value up to and including
+ *  its matching closing tag.
+ * @param reader - reader to use
+ * @param closing_len - [out] length of the closing tag of a constructed
+ *  value, or zero for a primitive value; may be NULL
+ * @return number of bytes skipped, or BACNET_STATUS_ERROR
+ */
+static int
+bacnet_reader_skip_element(BACNET_READER *reader, uint8_t *closing_len)
+{
+    const BACNET_TAG *tag;
+    uint32_t start;
+    uint32_t depth = 0;
+    uint8_t opening_tag_number;
+
+    tag = bacnet_reader_peek(reader);
+    if (!tag || tag->closing) {
+        /* nothing to skip, or the end of an enclosing element */
+        return BACNET_STATUS_ERROR;
+    }
+    start = reader->offset;
+    opening_tag_number = tag->number;
+    if (closing_len) {
+        *closing_len = 0;
+    }
+    do {
+        tag = bacnet_reader_peek(reader);
+        if (!tag) {
+            /* error: missing closing tag */
+            reader->error = true;
+            return BACNET_STATUS_ERROR;
+        }
+        if (tag->opening) {
+            depth++;
+        } else if (tag->closing) {
+            depth--;
+            if (depth == 0) {
+                if (tag->number != opening_tag_number) {
+                    /* error: mismatched closing tag */
+                    reader->error = true;
+                    return BACNET_STATUS_ERROR;
+                }
+                if (closing_len) {
+                    *closing_len = reader->tag_len;
+                }
+            }
+        }
+        bacnet_reader_consume(reader, reader->tag_len + reader->data_len);
+    } while (depth > 0);
+    if ((reader->offset - start) > INT_MAX) {
+        reader->error = true;
+        return BACNET_STATUS_ERROR;
+    }
+
+    return (int)(reader->offset - start);
+}
+
+/**
+ * @brief Skip the element at the reader cursor in a single pass
+ * @param reader - reader to use
+ * @return number of bytes skipped, or BACNET_STATUS_ERROR
+ */
+int bacnet_reader_skip(BACNET_READER *reader)
+{
+    return bacnet_reader_skip_element(reader, NULL);
+}
+
+/**
+ * @brief Consume a constructed value enclosed in a specific context tag
+ *  and get a reference to the data between its opening and closing tags,
+ *  walking the enclosed tags only once.
+ * @param reader - reader to use
+ * @param tag_number - context tag number of the opening and closing tags
+ * @param data - [out] start of the enclosed data; may be NULL
+ * @param data_len - [out] length of the enclosed data; may be NULL
+ * @return true if the enclosed value was consumed
+ */
+bool bacnet_reader_enclosed(
+    BACNET_READER *reader,
+    uint8_t tag_number,
+    const uint8_t **data,
+    uint32_t *data_len)
+{
+    uint32_t start;
+    uint8_t opening_len;
+    uint8_t closing_len = 0;
+
+    if (!bacnet_reader_is_opening(reader, tag_number)) {
+        return false;
+    }
+    opening_len = reader->tag_len;
+    start = reader->offset + opening_len;
+    if (bacnet_reader_skip_element(reader, &closing_len) < 0) {
+        return false;
+    }
+    if (data) {
+        *data = &reader->apdu[start];
+    }
+    if (data_len) {
+        *data_len = reader->offset - closing_len - start;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Find a primitive value at the reader cursor
+ * @param reader - reader to use
+ * @param context - true for a context tag, false for an application tag
+ * @param tag_number - context or application tag number to match
+ * @return pointer to the value data, or NULL if the tag does not match
+ */
+static const uint8_t *bacnet_reader_primitive(
+    BACNET_READER *reader, bool context, uint8_t tag_number)
+{
+    const BACNET_TAG *tag = bacnet_reader_peek(reader);
+
+    if (!tag || (tag->number != tag_number)) {
+        return NULL;
+    }
+    if (context ? !tag->context : !tag->application) {
+        return NULL;
+    }
+
+    return &reader->apdu[reader->offset + reader->tag_len];
+}
+
+/**
+ * @brief Consume the primitive value at the reader cursor once it has
+ *  been decoded, flagging a value whose length is not its tag length.
+ * @param reader - reader to use
+ * @param len - number of value bytes that the decoder used
+ * @return true if the value was consumed
+ */
+static bool bacnet_reader_primitive_end(BACNET_READER *reader, int len)
+{
+    if ((len < 0) || ((uint32_t)len != reader->data_len)) {
+        reader->error = true;
+        return false;
+    }
+    bacnet_reader_consume(reader, reader->tag_len + reader->data_len);
+
+    return true;
+}
+
+static bool bacnet_reader_unsigned_value(
+    BACNET_READER *reader,
+    bool context,
+    uint8_t tag_number,
+    BACNET_UNSIGNED_INTEGER *value)
+{
+    const uint8_t *data;
+    int len;
+
+    data = bacnet_reader_primitive(reader, context, tag_number);
+    if (!data) {
+        return false;
+    }
+    len = bacnet_unsigned_decode(
+        data, reader->data_len, reader->tag.len_value_type, value);
+    if (len == 0) {
+        len = BACNET_STATUS_ERROR;
+    }
+
+    return bacnet_reader_primitive_end(reader, len);
+}
+
+static bool bacnet_reader_enumerated_value(
+    BACNET_READER *reader, bool context, uint8_t tag_number, uint32_t *value)
+{
+    const uint8_t *data;
+    int len;
+
+    data = bacnet_reader_primitive(reader, context, tag_number);
+    if (!data) {
+        return false;
+    }
+    len = bacnet_enumerated_decode(
+        data, reader->data_len, reader->tag.len_value_type, value);
+    if (len == 0) {
+        len = BACNET_STATUS_ERROR;
+    }
+
+    return bacnet_reader_primitive_end(reader, len);
+}
+
+static bool bacnet_reader_object_id_value(
+    BACNET_READER *reader,
+    bool context,
+    uint8_t tag_number,
+    BACNET_OBJECT_TYPE *object_type,
+    uint32_t *object_instance)
+{
+    const uint8_t *data;
+    int len;
+
+    data = bacnet_reader_primitive(reader, context, tag_number);
+    if (!data) {
+        return false;
+    }
+    if (reader->data_len != 4) {
+        len = BACNET_STATUS_ERROR;
+    } else {
+        len = bacnet_object_id_decode(
+            data, reader->data_len, reader->tag.len_value_type, object_type,
+            object_instance);
+    }
+
+    return bacnet_reader_primitive_end(reader, len);
+}
+
+/**
+ * @brief Decode and consume an application tagged Unsigned value
+ * @param reader - reader to use
+ * @param value - [out] decoded value; may be NULL
+ * @return true if the value was decoded. False without an error means
+ *  that the cursor is at some other tag, which is left in place.
+ */
+bool bacnet_reader_application_unsigned(
+    BACNET_READER *reader, BACNET_UNSIGNED_INTEGER *value)
+{
+    return bacnet_reader_unsigned_value(
+        reader, false, BACNET_APPLICATION_TAG_UNSIGNED_INT, value);
+}
+
+/**
+ * @brief Decode and consume a context tagged Unsigned value
+ * @param reader - reader to use
+ * @param tag_number - context tag number to match
+ * @param value - [out] decoded value; may be NULL
+ * @return true if the value was decoded. False without an error means
+ *  that the cursor is at some other tag, which is left in place.
+ */
+bool bacnet_reader_context_unsigned(
+    BACNET_READER *reader, uint8_t tag_number, BACNET_UNSIGNED_INTEGER *value)
+{
+    return bacnet_reader_unsigned_value(reader, true, tag_number, value);
+}
+
+/**
+ * @brief Decode and consume an application tagged Enumerated value
+ * @param reader - reader to use
+ * @param value - [out] decoded value; may be NULL
+ * @return true if the value was decoded. False without an error means
+ *  that the cursor is at some other tag, which is left in place.
+ */
+bool bacnet_reader_application_enumerated(
+    BACNET_READER *reader, uint32_t *value)
+{
+    return bacnet_reader_enumerated_value(
+        reader, false, BACNET_APPLICATION_TAG_ENUMERATED, value);
+}
+
+/**
+ * @brief Decode and consume a context tagged Enumerated value
+ * @param reader - reader to use
+ * @param tag_number - context tag number to match
+ * @param value - [out] decoded value; may be NULL
+ * @return true if the value was decoded. False without an error means
+ *  that the cursor is at some other tag, which is left in place.
+ */
+bool bacnet_reader_context_enumerated(
+    BACNET_READER *reader, uint8_t tag_number, uint32_t *value)
+{
+    return bacnet_reader_enumerated_value(reader, true, tag_number, value);
+}
+
+/**
+ * @brief Decode and consume an application tagged Object Identifier
+ * @param reader - reader to use
+ * @param object_type - [out] decoded object type; may be NULL
+ * @param object_instance - [out] decoded object instance; may be NULL
+ * @return true if the value was decoded. False without an error means
+ *  that the cursor is at some other tag, which is left in place.
+ */
+bool bacnet_reader_application_object_id(
+    BACNET_READER *reader,
+    BACNET_OBJECT_TYPE *object_type,
+    uint32_t *object_instance)
+{
+    return bacnet_reader_object_id_value(
+        reader, false, BACNET_APPLICATION_TAG_OBJECT_ID, object_type,
+        object_instance);
+}
+
+/**
+ * @brief Decode and consume a context tagged Object Identifier
+ * @param reader - reader to use
+ * @param tag_number - context tag number to match
+ * @param object_type - [out] decoded object type; may be NULL
+ * @param object_instance - [out] decoded object instance; may be NULL
+ * @return true if the value was decoded. False without an error means
+ *  that the cursor is at some other tag, which is left in place.
+ */
+bool bacnet_reader_context_object_id(
+    BACNET_READER *reader,
+    uint8_t tag_number,
+    BACNET_OBJECT_TYPE *object_type,
+    uint32_t *object_instance)
+{
+    return bacnet_reader_object_id_value(
+        reader, true, tag_number, object_type, object_instance);
+}
+
+/**
+ * @brief Decode and consume an application tagged Boolean value
+ * @param reader - reader to use
+ * @param value - [out] decoded value; may be NULL
+ * @return true if the value was decoded. False without an error means
+ *  that the cursor is at some other tag, which is left in place.
+ */
+bool bacnet_reader_application_boolean(BACNET_READER *reader, bool *value)
+{
+    if (!bacnet_reader_primitive(
+            reader, false, BACNET_APPLICATION_TAG_BOOLEAN)) {
+        return false;
+    }
+    if (value) {
+        *value = reader->tag.len_value_type ? true : false;
+    }
+
+    return bacnet_reader_primitive_end(reader, 0);
+}
+
+/**
+ * @brief Decode and consume an application tagged Signed value
+ * @param reader - reader to use
+ * @param value - [out] decoded value; may be NULL
+ * @return true if the value was decoded. False without an error means
+ *  that the cursor is at some other tag, which is left in place.
+ */
+bool bacnet_reader_application_signed(BACNET_READER *reader, int32_t *value)
+{
+    const uint8_t *data;
+    int32_t signed_value = 0;
+    int len;
+
+    data = bacnet_reader_primitive(
+        reader, false, BACNET_APPLICATION_TAG_SIGNED_INT);
+    if (!data) {
+        return false;
+    }
+    len = bacnet_signed_decode(
+        data, reader->data_len, reader->tag.len_value_type, &signed_value);
+    if (len == 0) {
+        len = BACNET_STATUS_ERROR;
+    } else if (value) {
+        *value = signed_value;
+    }
+
+    return bacnet_reader_primitive_end(reader, len);
+}
+
+/**
+ * @brief Decode and consume an application tagged Real value
+ * @param reader - reader to use
+ * @param value - [out] decoded value; may be NULL
+ * @return true if the value was decoded. False without an error means
+ *  that the cursor is at some other tag, which is left in place.
+ */
+bool bacnet_reader_application_real(BACNET_READER *reader, float *value)
+{
+    const uint8_t *data;
+    float real_value = 0.0f;
+    int len;
+
+    data = bacnet_reader_primitive(reader, false, BACNET_APPLICATION_TAG_REAL);
+    if (!data) {
+        return false;
+    }
+    len = bacnet_real_decode(
+        data, reader->data_len, reader->tag.len_value_type, &real_value);
+    if (len == 0) {
+        len = BACNET_STATUS_ERROR;
+    } else if (value) {
+        *value = real_value;
+    }
+
+    return bacnet_reader_primitive_end(reader, len);
+}
+
 #if defined(BACNET_STACK_DEPRECATED_DISABLE)
 /**
  * @brief Returns true if the tag is context specific
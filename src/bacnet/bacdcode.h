@@ -91,6 +91,25 @@ typedef struct BACnetTag {
 /* max size of a BACnet tag */
 #define BACNET_TAG_SIZE 7
 
+/**
+ * A cursor over encoded BACnet data that decodes one tag at a time in
+ * place. Values are decoded only when asked for, and constructed data
+ * can be skipped or referenced in a single pass.
+ */
+typedef struct BACnetReader {
+    const uint8_t *apdu;
+    uint32_t apdu_size;
+    /* number of bytes consumed */
+    uint32_t offset;
+    /* tag at the offset, valid when tag_len is not zero */
+    BACNET_TAG tag;
+    uint8_t tag_len;
+    /* number of primitive value bytes that follow the tag */
+    uint32_t data_len;
+    /* true once malformed data is found */
+    bool error : 1;
+} BACNET_READER;
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -146,6 +165,67 @@ int bacnet_application_data_length(uint8_t tag_number, uint32_t len_value_type);
 BACNET_STACK_EXPORT
 int bacnet_enclosed_data_length(const uint8_t *apdu, size_t apdu_size);
 
+BACNET_STACK_EXPORT
+void bacnet_reader_init(
+    BACNET_READER *reader, const uint8_t *apdu, uint32_t apdu_size);
+BACNET_STACK_EXPORT
+const BACNET_TAG *bacnet_reader_peek(BACNET_READER *reader);
+BACNET_STACK_EXPORT
+uint32_t bacnet_reader_offset(const BACNET_READER *reader);
+BACNET_STACK_EXPORT
+uint32_t bacnet_reader_remaining(const BACNET_READER *reader);
+BACNET_STACK_EXPORT
+const uint8_t *bacnet_reader_data(const BACNET_READER *reader);
+BACNET_STACK_EXPORT
+bool bacnet_reader_error(const BACNET_READER *reader);
+BACNET_STACK_EXPORT
+bool bacnet_reader_advance(BACNET_READER *reader, uint32_t len);
+BACNET_STACK_EXPORT
+bool bacnet_reader_is_opening(BACNET_READER *reader, uint8_t tag_number);
+BACNET_STACK_EXPORT
+bool bacnet_reader_is_closing(BACNET_READER *reader, uint8_t tag_number);
+BACNET_STACK_EXPORT
+bool bacnet_reader_opening(BACNET_READER *reader, uint8_t tag_number);
+BACNET_STACK_EXPORT
+bool bacnet_reader_closing(BACNET_READER *reader, uint8_t tag_number);
+BACNET_STACK_EXPORT
+int bacnet_reader_skip(BACNET_READER *reader);
+BACNET_STACK_EXPORT
+bool bacnet_reader_enclosed(
+    BACNET_READER *reader,
+    uint8_t tag_number,
+    const uint8_t **data,
+    uint32_t *data_len);
+BACNET_STACK_EXPORT
+bool bacnet_reader_application_unsigned(
+    BACNET_READER *reader, BACNET_UNSIGNED_INTEGER *value);
+BACNET_STACK_EXPORT
+bool bacnet_reader_context_unsigned(
+    BACNET_READER *reader, uint8_t tag_number, BACNET_UNSIGNED_INTEGER *value);
+BACNET_STACK_EXPORT
+bool bacnet_reader_application_enumerated(
+    BACNET_READER *reader, uint32_t *value);
+BACNET_STACK_EXPORT
+bool bacnet_reader_context_enumerated(
+    BACNET_READER *reader, uint8_t tag_number, uint32_t *value);
+BACNET_STACK_EXPORT
+bool bacnet_reader_application_object_id(
+    BACNET_READER *reader,
+    BACNET_OBJECT_TYPE *object_type,
+    uint32_t *object_instance);
+BACNET_STACK_EXPORT
+bool bacnet_reader_context_object_id(
+    BACNET_READER *reader,
+    uint8_t tag_number,
+    BACNET_OBJECT_TYPE *object_type,
+    uint32_t *object_instance);
+BACNET_STACK_EXPORT
+bool bacnet_reader_application_boolean(BACNET_READER *reader, bool *value);
+BACNET_STACK_EXPORT
+bool bacnet_reader_application_signed(BACNET_READER *reader, int32_t *value);
+BACNET_STACK_EXPORT
+bool bacnet_reader_application_real(BACNET_READER *reader, float *value);
+
 BACNET_STACK_DEPRECATED("Use bacnet_tag_decode() instead")
 BACNET_STACK_EXPORT
 int bacnet_tag_number_and_value_decode(
@@ -439,6 +439,61 @@ bool bacnet_discover_property_value(
     return status;
 }
 
+/**
+ * @brief Get a property value from the device cache as a compact value
+ *  that references the cached encoding instead of copying it
+ * @param device_id - ID of the destination device
+ * @param object_type - BACnet object type
+ * @param object_instance - Instance number of the object to be read.
+ * @param object_property - BACnet property identifier
+ * @param value property value stored if available (see tag for type)
+ * @return true if found and value loaded
+ * @note the value is valid until the device cache is refreshed or cleaned
+ */
+bool bacnet_discover_property_compact(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    BACNET_COMPACT_VALUE *value)
+{
+    bool status = false;
+    BACNET_DEVICE_DATA *device;
+    BACNET_OBJECT_DATA *object;
+    BACNET_PROPERTY_DATA *property;
+    KEY key = device_id;
+    int len = 0;
+
+    if (!value) {
+        return false;
+    }
+    device = Keylist_Data(Device_List, key);
+    if (device) {
+        key = KEY_ENCODE(object_type, object_instance);
+        object = Keylist_Data(device->Object_List, key);
+        if (object) {
+            key = object_property;
+            property = Keylist_Data(object->Property_List, key);
+            if (property) {
+                if (property->application_data_len > 0) {
+                    len = bacapp_compact_decode_known_property(
+                        property->application_data,
+                        property->application_data_len, value, object_type,
+                        object_property);
+                    if (len > 0) {
+                        status = true;
+                    }
+                } else {
+                    memset(value, 0, sizeof(*value));
+                    status = true;
+                }
+            }
+        }
+    }
+
+    return status;
+}
+
 /**
  * @brief Get a name property value from the device object property cache
  * @param device_id - ID of the destination device
@@ -13,6 +13,7 @@
 #include "bacnet/bacdef.h"
 /* BACnet Stack API */
 #include "bacnet/bacapp.h"
+#include "bacnet/bacapp_compact.h"
 #include "bacnet/rp.h"
 
 /**
@@ -76,6 +77,13 @@ bool bacnet_discover_property_value(
     BACNET_PROPERTY_ID object_property,
     BACNET_APPLICATION_DATA_VALUE *value);
 BACNET_STACK_EXPORT
+bool bacnet_discover_property_compact(
+    uint32_t device_id,
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    BACNET_PROPERTY_ID object_property,
+    BACNET_COMPACT_VALUE *value);
+BACNET_STACK_EXPORT
 bool bacnet_discover_property_name(
     uint32_t device_id,
     BACNET_OBJECT_TYPE object_type,
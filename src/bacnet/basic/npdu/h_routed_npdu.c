@@ -186,6 +186,8 @@ static void routed_apdu_handler(
     uint16_t apdu_len)
 {
     int cursor = 0; /* Starting hint */
+    uint16_t device_index = 0;
+    uint16_t previous_index;
     bool bGotOne = false;
 
     if (!Routed_Device_Is_Valid_Network(dest->net, DNET_list)) {
@@ -217,13 +219,18 @@ static void routed_apdu_handler(
         return;
     }
 
-    while (Routed_Device_GetNext(dest, DNET_list, &cursor)) {
+    /* each matching Device is the context for one pass of the handler,
+       then the previously selected Device is restored */
+    previous_index = Routed_Device_Object_Index();
+    while (Routed_Device_Find_Next(dest, DNET_list, &cursor, &device_index)) {
+        Set_Routed_Device_Object_Index(device_index);
         apdu_handler(src, apdu, apdu_len);
         bGotOne = true;
         if (cursor < 0) { /* If no more matches, */
             break; /* We don't need to keep looking */
         }
     }
+    Set_Routed_Device_Object_Index(previous_index);
     if (!bGotOne) {
         /* Just silently drop this packet. */
         debug_printf("NPDU: dest not found - dropped!\n");
@@ -0,0 +1,594 @@
+/**
+ * @file
+ * @brief BACnet router routing table with hashed DNET lookup
+ * @details The routing table holds the directly connected router ports
+ * and the networks reachable through each port. Networks are kept in an
+ * open addressing hash table keyed by network number, so that finding
+ * the port for a routed NPDU does not depend on the number of networks.
+ * The broadcast fan-out for each source port is cached and rebuilt only
+ * when a port is added, enabled, or disabled.
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2026
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+/* BACnet Stack defines - first */
+#include "bacnet/bacdef.h"
+/* BACnet Stack API */
+#include "bacnet/basic/npdu/router_table.h"
+
+/**
+ * @brief Compute the hash slot for a network number
+ * @param size - number of slots in the hash table, a power of two
+ * @param net - network number
+ * @return hash slot index
+ */
+static unsigned router_table_hash(unsigned size, uint16_t net)
+{
+    /* Fibonacci hashing spreads sequential network numbers */
+    uint32_t hash = (uint32_t)net * 2654435769UL;
+
+    return (unsigned)(hash >> 16) & (size - 1);
+}
+
+/**
+ * @brief Find the slot that holds a network, or the empty slot where
+ *  the network would be stored
+ * @param table - routing table
+ * @param net - network number
+ * @return pointer to the slot, or NULL if the table has no slots
+ */
+static BACNET_ROUTER_TABLE_ENTRY *
+router_table_slot(const BACNET_ROUTER_TABLE *table, uint16_t net)
+{
+    BACNET_ROUTER_TABLE_ENTRY *entry;
+    unsigned index;
+
+    if (!table->entry) {
+        return NULL;
+    }
+    index = router_table_hash(table->entry_size, net);
+    for (;;) {
+        entry = &table->entry[index];
+        if ((entry->net == net) || (entry->net == 0)) {
+            return entry;
+        }
+        index = (index + 1) & (table->entry_size - 1);
+    }
+}
+
+/**
+ * @brief Resize the hash table and re-insert the current networks
+ * @param table - routing table
+ * @param size - new number of slots, a power of two
+ * @return true if the table was resized
+ */
+static bool router_table_resize(BACNET_ROUTER_TABLE *table, unsigned size)
+{
+    BACNET_ROUTER_TABLE_ENTRY *old_entry = table->entry;
+    unsigned old_size = table->entry_size;
+    BACNET_ROUTER_TABLE_ENTRY *entry;
+    unsigned i;
+
+    entry = calloc(size, sizeof(BACNET_ROUTER_TABLE_ENTRY));
+    if (!entry) {
+        return false;
+    }
+    table->entry = entry;
+    table->entry_size = size;
+    for (i = 0; i < old_size; i++) {
+        if (old_entry[i].net != 0) {
+            entry = router_table_slot(table, old_entry[i].net);
+            *entry = old_entry[i];
+        }
+    }
+    free(old_entry);
+
+    return true;
+}
+
+/**
+ * @brief Get a slot for a new or existing network, growing the table
+ *  to keep the load factor at or below one half
+ * @param table - routing table
+ * @param net - network number
+ * @return pointer to the slot, or NULL if out of memory
+ */
+static BACNET_ROUTER_TABLE_ENTRY *
+router_table_slot_add(BACNET_ROUTER_TABLE *table, uint16_t net)
+{
+    BACNET_ROUTER_TABLE_ENTRY *entry;
+    unsigned size;
+
+    entry = router_table_slot(table, net);
+    if (entry && (entry->net == net)) {
+        return entry;
+    }
+    if (((table->entry_count + 1) * 2) > table->entry_size) {
+        size = table->entry_size * 2;
+        if (size < BACNET_ROUTER_TABLE_SIZE_MIN) {
+            size = BACNET_ROUTER_TABLE_SIZE_MIN;
+        }
+        if (!router_table_resize(table, size)) {
+            return NULL;
+        }
+        entry = router_table_slot(table, net);
+    }
+    if (entry) {
+        memset(entry, 0, sizeof(BACNET_ROUTER_TABLE_ENTRY));
+        entry->net = net;
+        table->entry_count++;
+    }
+
+    return entry;
+}
+
+/**
+ * @brief Rebuild the cached broadcast fan-out lists of each port
+ * @param table - routing table
+ */
+static void router_table_broadcast_update(BACNET_ROUTER_TABLE *table)
+{
+    unsigned source, target, count;
+
+    table->broadcast_all_count = 0;
+    for (target = 0; target < table->port_count; target++) {
+        if (table->port[target].enabled) {
+            table->broadcast_all[table->broadcast_all_count] = (uint8_t)target;
+            table->broadcast_all_count++;
+        }
+    }
+    for (source = 0; source < table->port_count; source++) {
+        count = 0;
+        for (target = 0; target < table->port_count; target++) {
+            if ((target != source) && table->port[target].enabled) {
+                table->broadcast[source][count] = (uint8_t)target;
+                count++;
+            }
+        }
+        table->broadcast_count[source] = (uint8_t)count;
+    }
+}
+
+/**
+ * @brief Determine if a network is directly connected to a router port
+ * @param table - routing table
+ * @param entry - network entry
+ * @return true if the network is directly connected
+ */
+static bool router_table_entry_direct(
+    const BACNET_ROUTER_TABLE *table, const BACNET_ROUTER_TABLE_ENTRY *entry)
+{
+    return (entry->port_index < table->port_count) &&
+        (table->port[entry->port_index].net == entry->net);
+}
+
+/**
+ * @brief Initialize an empty routing table
+ * @param table - routing table
+ */
+void bacnet_router_table_init(BACNET_ROUTER_TABLE *table)
+{
+    if (table) {
+        memset(table, 0, sizeof(BACNET_ROUTER_TABLE));
+    }
+}
+
+/**
+ * @brief Free the memory used by a routing table and empty it
+ * @param table - routing table
+ */
+void bacnet_router_table_cleanup(BACNET_ROUTER_TABLE *table)
+{
+    if (table) {
+        free(table->entry);
+        bacnet_router_table_init(table);
+    }
+}
+
+/**
+ * @brief Add a directly connected port to the routing table
+ * @param table - routing table
+ * @param net - network number of the directly connected network
+ * @param addr - MAC address of the port on its network, or NULL
+ * @param context - application specific data for the port, or NULL
+ * @return index of the port, or -1 if the port could not be added
+ */
+int bacnet_router_table_port_add(
+    BACNET_ROUTER_TABLE *table,
+    uint16_t net,
+    const BACNET_ADDRESS *addr,
+    void *context)
+{
+    BACNET_ROUTER_TABLE_PORT *port;
+    BACNET_ROUTER_TABLE_ENTRY *entry;
+    unsigned port_index;
+    int index;
+
+    if (!table || (net == 0) || (net == BACNET_BROADCAST_NETWORK)) {
+        return -1;
+    }
+    index = bacnet_router_table_port_index(table, net);
+    if (index >= 0) {
+        return index;
+    }
+    if (table->port_count >= BACNET_ROUTER_TABLE_PORTS_MAX) {
+        return -1;
+    }
+    entry = router_table_slot_add(table, net);
+    if (!entry) {
+        return -1;
+    }
+    port_index = table->port_count;
+    port = &table->port[port_index];
+    memset(port, 0, sizeof(BACNET_ROUTER_TABLE_PORT));
+    port->net = net;
+    if (addr) {
+        port->mac_len = addr->mac_len;
+        memcpy(port->mac, addr->mac, MAX_MAC_LEN);
+    }
+    port->enabled = true;
+    port->context = context;
+    table->port_count++;
+    /* a directly connected network replaces any learned route */
+    entry->port_index = (uint8_t)port_index;
+    entry->status = BACNET_ROUTER_TABLE_REACHABLE;
+    entry->mac_len = 0;
+    memset(entry->mac, 0, MAX_MAC_LEN);
+    router_table_broadcast_update(table);
+
+    return (int)port_index;
+}
+
+/**
+ * @brief Get the number of directly connected ports
+ * @param table - routing table
+ * @return number of ports
+ */
+unsigned bacnet_router_table_port_count(const BACNET_ROUTER_TABLE *table)
+{
+    if (!table) {
+        return 0;
+    }
+
+    return table->port_count;
+}
+
+/**
+ * @brief Get a directly connected port by its index
+ * @param table - routing table
+ * @param port_index - index of the port
+ * @return pointer to the port, or NULL if the index is invalid
+ */
+BACNET_ROUTER_TABLE_PORT *
+bacnet_router_table_port(BACNET_ROUTER_TABLE *table, unsigned port_index)
+{
+    if (!table || (port_index >= table->port_count)) {
+        return NULL;
+    }
+
+    return &table->port[port_index];
+}
+
+/**
+ * @brief Get the index of the port directly connected to a network
+ * @param table - routing table
+ * @param net - network number of the directly connected network
+ * @return index of the port, or -1 if not directly connected
+ */
+int bacnet_router_table_port_index(
+    const BACNET_ROUTER_TABLE *table, uint16_t net)
+{
+    const BACNET_ROUTER_TABLE_ENTRY *entry;
+
+    if (!table || (net == 0)) {
+        return -1;
+    }
+    entry = router_table_slot(table, net);
+    if (entry && (entry->net == net) &&
+        router_table_entry_direct(table, entry)) {
+        return entry->port_index;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Find the port directly connected to a network
+ * @param table - routing table
+ * @param net - network number of the directly connected network
+ * @return pointer to the port, or NULL if not directly connected
+ */
+BACNET_ROUTER_TABLE_PORT *
+bacnet_router_table_port_find(BACNET_ROUTER_TABLE *table, uint16_t net)
+{
+    int index;
+
+    index = bacnet_router_table_port_index(table, net);
+    if (index < 0) {
+        return NULL;
+    }
+
+    return &table->port[index];
+}
+
+/**
+ * @brief Enable or disable a directly connected port. A disabled port
+ *  is removed from the cached broadcast fan-out lists.
+ * @param table - routing table
+ * @param port_index - index of the port
+ * @param enabled - true if the port is able to send and receive
+ * @return true if the port was found
+ */
+bool bacnet_router_table_port_enabled_set(
+    BACNET_ROUTER_TABLE *table, unsigned port_index, bool enabled)
+{
+    if (!table || (port_index >= table->port_count)) {
+        return false;
+    }
+    if (table->port[port_index].enabled != enabled) {
+        table->port[port_index].enabled = enabled;
+        router_table_broadcast_update(table);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Add or update a network reachable through a router port
+ * @param table - routing table
+ * @param snet - network number of the directly connected port
+ * @param net - network number that is reachable
+ * @param addr - address of the next router on the path to the network
+ * @return true if the network was added or updated, false if the port
+ *  is unknown, the network is directly connected, or out of memory
+ */
+bool bacnet_router_table_dnet_add(
+    BACNET_ROUTER_TABLE *table,
+    uint16_t snet,
+    uint16_t net,
+    const BACNET_ADDRESS *addr)
+{
+    BACNET_ROUTER_TABLE_ENTRY *entry;
+    int port_index;
+
+    if (!table || (net == 0) || (net == BACNET_BROADCAST_NETWORK)) {
+        return false;
+    }
+    port_index = bacnet_router_table_port_index(table, snet);
+    if (port_index < 0) {
+        return false;
+    }
+    entry = router_table_slot(table, net);
+    if (entry && (entry->net == net) &&
+        router_table_entry_direct(table, entry)) {
+        return false;
+    }
+    entry = router_table_slot_add(table, net);
+    if (!entry) {
+        return false;
+    }
+    entry->port_index = (uint8_t)port_index;
+    entry->status = BACNET_ROUTER_TABLE_REACHABLE;
+    if (addr) {
+        entry->mac_len = addr->mac_len;
+        memcpy(entry->mac, addr->mac, MAX_MAC_LEN);
+    } else {
+        entry->mac_len = 0;
+        memset(entry->mac, 0, MAX_MAC_LEN);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Remove a network reachable through a router port
+ * @note Directly connected networks are not removed.
+ * @param table - routing table
+ * @param net - network number
+ * @return true if the network was removed
+ */
+bool bacnet_router_table_dnet_remove(BACNET_ROUTER_TABLE *table, uint16_t net)
+{
+    BACNET_ROUTER_TABLE_ENTRY *entry;
+    unsigned mask, i, j, k;
+
+    if (!table || (net == 0)) {
+        return false;
+    }
+    entry = router_table_slot(table, net);
+    if (!entry || (entry->net != net) ||
+        router_table_entry_direct(table, entry)) {
+        return false;
+    }
+    /* backward shift deletion keeps the probe sequences intact */
+    mask = table->entry_size - 1;
+    i = (unsigned)(entry - table->entry);
+    j = i;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (table->entry[j].net == 0) {
+            break;
+        }
+        k = router_table_hash(table->entry_size, table->entry[j].net);
+        if ((i <= j) ? ((i < k) && (k <= j)) : ((i < k) || (k <= j))) {
+            continue;
+        }
+        table->entry[i] = table->entry[j];
+        i = j;
+    }
+    memset(&table->entry[i], 0, sizeof(BACNET_ROUTER_TABLE_ENTRY));
+    table->entry_count--;
+
+    return true;
+}
+
+/**
+ * @brief Find a network in the routing table
+ * @param table - routing table
+ * @param net - network number
+ * @return pointer to the network entry, or NULL if not found
+ */
+BACNET_ROUTER_TABLE_ENTRY *
+bacnet_router_table_dnet_find(BACNET_ROUTER_TABLE *table, uint16_t net)
+{
+    BACNET_ROUTER_TABLE_ENTRY *entry;
+
+    if (!table || (net == 0)) {
+        return NULL;
+    }
+    entry = router_table_slot(table, net);
+    if (entry && (entry->net == net)) {
+        return entry;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Get the number of networks in the routing table, including
+ *  the directly connected networks
+ * @param table - routing table
+ * @return number of networks
+ */
+unsigned bacnet_router_table_dnet_count(const BACNET_ROUTER_TABLE *table)
+{
+    if (!table) {
+        return 0;
+    }
+
+    return table->entry_count;
+}
+
+/**
+ * @brief Iterate the networks in the routing table in no particular order
+ * @param table - routing table
+ * @param cursor - iteration state, set to 0 before the first call
+ * @return pointer to the next network entry, or NULL when done
+ */
+BACNET_ROUTER_TABLE_ENTRY *
+bacnet_router_table_dnet_next(BACNET_ROUTER_TABLE *table, unsigned *cursor)
+{
+    BACNET_ROUTER_TABLE_ENTRY *entry;
+
+    if (!table || !cursor) {
+        return NULL;
+    }
+    while (*cursor < table->entry_size) {
+        entry = &table->entry[*cursor];
+        (*cursor)++;
+        if (entry->net != 0) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Find the router port to use to reach a network
+ * @param table - routing table
+ * @param net - destination network number
+ * @param addr - if not NULL and the network is reached through another
+ *  router, the MAC address of that router is copied into addr->mac.
+ *  The caller compares the returned port->net with the sought after
+ *  net to determine whether addr was filled.
+ * @return pointer to the port, or NULL if the network is unknown
+ */
+BACNET_ROUTER_TABLE_PORT *bacnet_router_table_route(
+    BACNET_ROUTER_TABLE *table, uint16_t net, BACNET_ADDRESS *addr)
+{
+    const BACNET_ROUTER_TABLE_ENTRY *entry;
+
+    entry = bacnet_router_table_dnet_find(table, net);
+    if (!entry) {
+        return NULL;
+    }
+    if (addr && !router_table_entry_direct(table, entry)) {
+        addr->mac_len = entry->mac_len;
+        memcpy(addr->mac, entry->mac, MAX_MAC_LEN);
+    }
+
+    return &table->port[entry->port_index];
+}
+
+/**
+ * @brief Set the reachability status of a network
+ * @param table - routing table
+ * @param net - network number
+ * @param status - reachability status
+ * @return true if the network was found
+ */
+bool bacnet_router_table_status_set(
+    BACNET_ROUTER_TABLE *table,
+    uint16_t net,
+    BACNET_ROUTER_TABLE_STATUS status)
+{
+    BACNET_ROUTER_TABLE_ENTRY *entry;
+
+    entry = bacnet_router_table_dnet_find(table, net);
+    if (!entry) {
+        return false;
+    }
+    entry->status = (uint8_t)status;
+
+    return true;
+}
+
+/**
+ * @brief Get the reachability status of a network
+ * @param table - routing table
+ * @param net - network number
+ * @return reachability status, BACNET_ROUTER_TABLE_UNREACHABLE when the
+ *  network is unknown
+ */
+BACNET_ROUTER_TABLE_STATUS
+bacnet_router_table_status(BACNET_ROUTER_TABLE *table, uint16_t net)
+{
+    const BACNET_ROUTER_TABLE_ENTRY *entry;
+
+    entry = bacnet_router_table_dnet_find(table, net);
+    if (!entry) {
+        return BACNET_ROUTER_TABLE_UNREACHABLE;
+    }
+
+    return (BACNET_ROUTER_TABLE_STATUS)entry->status;
+}
+
+/**
+ * @brief Get the cached list of ports to which a broadcast received on
+ *  a port is forwarded: every enabled port except the source port.
+ * @param table - routing table
+ * @param snet - network number of the port where the broadcast was
+ *  received, or 0 to get every enabled port
+ * @param count - filled with the number of ports in the list
+ * @return array of port indexes
+ */
+const uint8_t *bacnet_router_table_broadcast_ports(
+    const BACNET_ROUTER_TABLE *table, uint16_t snet, unsigned *count)
+{
+    int port_index;
+
+    if (!table) {
+        if (count) {
+            *count = 0;
+        }
+        return NULL;
+    }
+    port_index = bacnet_router_table_port_index(table, snet);
+    if (port_index < 0) {
+        if (count) {
+            *count = table->broadcast_all_count;
+        }
+        return table->broadcast_all;
+    }
+    if (count) {
+        *count = table->broadcast_count[port_index];
+    }
+
+    return table->broadcast[port_index];
+}
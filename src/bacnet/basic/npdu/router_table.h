@@ -0,0 +1,148 @@
+/**
+ * @file
+ * @brief API for a BACnet router routing table with hashed DNET lookup
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2026
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#ifndef BACNET_BASIC_NPDU_ROUTER_TABLE_H
+#define BACNET_BASIC_NPDU_ROUTER_TABLE_H
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+/* BACnet Stack defines - first */
+#include "bacnet/bacdef.h"
+
+/* maximum number of directly connected router ports */
+#ifndef BACNET_ROUTER_TABLE_PORTS_MAX
+#define BACNET_ROUTER_TABLE_PORTS_MAX 16
+#endif
+
+/* initial number of hash slots allocated - must be a power of two */
+#ifndef BACNET_ROUTER_TABLE_SIZE_MIN
+#define BACNET_ROUTER_TABLE_SIZE_MIN 16
+#endif
+
+/**
+ * 6.6.1 Routing Tables - reachability status of a network.
+ * The status shall distinguish between "permanent" failures of a route
+ * and "temporary" unreachability due to congestion control.
+ */
+typedef enum bacnet_router_table_status {
+    BACNET_ROUTER_TABLE_REACHABLE = 0,
+    BACNET_ROUTER_TABLE_BUSY = 1,
+    BACNET_ROUTER_TABLE_UNREACHABLE = 2
+} BACNET_ROUTER_TABLE_STATUS;
+
+/* a directly connected router port */
+typedef struct bacnet_router_table_port {
+    /* network number of the directly connected network */
+    uint16_t net;
+    /* MAC address of the port's connection to its network */
+    uint8_t mac_len;
+    uint8_t mac[MAX_MAC_LEN];
+    /* port is able to send and receive */
+    bool enabled;
+    /* application specific port data */
+    void *context;
+} BACNET_ROUTER_TABLE_PORT;
+
+/* a network reachable through one of the router ports */
+typedef struct bacnet_router_table_entry {
+    /* network number, or 0 when the hash slot is empty */
+    uint16_t net;
+    /* index of the router port through which the network is reached */
+    uint8_t port_index;
+    /* BACNET_ROUTER_TABLE_STATUS */
+    uint8_t status;
+    /* MAC address of the next router on the path to the network.
+       The mac_len is 0 when the network is directly connected. */
+    uint8_t mac_len;
+    uint8_t mac[MAX_MAC_LEN];
+} BACNET_ROUTER_TABLE_ENTRY;
+
+typedef struct bacnet_router_table {
+    BACNET_ROUTER_TABLE_PORT port[BACNET_ROUTER_TABLE_PORTS_MAX];
+    unsigned port_count;
+    /* open addressing hash table of networks keyed by network number */
+    BACNET_ROUTER_TABLE_ENTRY *entry;
+    unsigned entry_size;
+    unsigned entry_count;
+    /* cached broadcast fan-out: for each source port index,
+       the enabled port indexes except the source port */
+    uint8_t broadcast[BACNET_ROUTER_TABLE_PORTS_MAX]
+                     [BACNET_ROUTER_TABLE_PORTS_MAX];
+    uint8_t broadcast_count[BACNET_ROUTER_TABLE_PORTS_MAX];
+    /* broadcast fan-out when the source is not one of our ports */
+    uint8_t broadcast_all[BACNET_ROUTER_TABLE_PORTS_MAX];
+    uint8_t broadcast_all_count;
+} BACNET_ROUTER_TABLE;
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+BACNET_STACK_EXPORT
+void bacnet_router_table_init(BACNET_ROUTER_TABLE *table);
+BACNET_STACK_EXPORT
+void bacnet_router_table_cleanup(BACNET_ROUTER_TABLE *table);
+
+BACNET_STACK_EXPORT
+int bacnet_router_table_port_add(
+    BACNET_ROUTER_TABLE *table,
+    uint16_t net,
+    const BACNET_ADDRESS *addr,
+    void *context);
+BACNET_STACK_EXPORT
+unsigned bacnet_router_table_port_count(const BACNET_ROUTER_TABLE *table);
+BACNET_STACK_EXPORT
+BACNET_ROUTER_TABLE_PORT *
+bacnet_router_table_port(BACNET_ROUTER_TABLE *table, unsigned port_index);
+BACNET_STACK_EXPORT
+int bacnet_router_table_port_index(
+    const BACNET_ROUTER_TABLE *table, uint16_t net);
+BACNET_STACK_EXPORT
+BACNET_ROUTER_TABLE_PORT *
+bacnet_router_table_port_find(BACNET_ROUTER_TABLE *table, uint16_t net);
+BACNET_STACK_EXPORT
+bool bacnet_router_table_port_enabled_set(
+    BACNET_ROUTER_TABLE *table, unsigned port_index, bool enabled);
+
+BACNET_STACK_EXPORT
+bool bacnet_router_table_dnet_add(
+    BACNET_ROUTER_TABLE *table,
+    uint16_t snet,
+    uint16_t net,
+    const BACNET_ADDRESS *addr);
+BACNET_STACK_EXPORT
+bool bacnet_router_table_dnet_remove(BACNET_ROUTER_TABLE *table, uint16_t net);
+BACNET_STACK_EXPORT
+BACNET_ROUTER_TABLE_ENTRY *
+bacnet_router_table_dnet_find(BACNET_ROUTER_TABLE *table, uint16_t net);
+BACNET_STACK_EXPORT
+unsigned bacnet_router_table_dnet_count(const BACNET_ROUTER_TABLE *table);
+BACNET_STACK_EXPORT
+BACNET_ROUTER_TABLE_ENTRY *bacnet_router_table_dnet_next(
+    BACNET_ROUTER_TABLE *table, unsigned *cursor);
+
+BACNET_STACK_EXPORT
+BACNET_ROUTER_TABLE_PORT *bacnet_router_table_route(
+    BACNET_ROUTER_TABLE *table, uint16_t net, BACNET_ADDRESS *addr);
+
+BACNET_STACK_EXPORT
+bool bacnet_router_table_status_set(
+    BACNET_ROUTER_TABLE *table,
+    uint16_t net,
+    BACNET_ROUTER_TABLE_STATUS status);
+BACNET_STACK_EXPORT
+BACNET_ROUTER_TABLE_STATUS
+bacnet_router_table_status(BACNET_ROUTER_TABLE *table, uint16_t net);
+
+BACNET_STACK_EXPORT
+const uint8_t *bacnet_router_table_broadcast_ports(
+    const BACNET_ROUTER_TABLE *table, uint16_t snet, unsigned *count);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif
@@ -1217,8 +1217,7 @@ int Analog_Input_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
 #endif
     struct analog_input_descr *pObject;
 
-    if ((rpdata == NULL) || (rpdata->application_data == NULL) ||
-        (rpdata->application_data_len == 0)) {
+    if ((rpdata == NULL) || (rpdata->application_data_len == 0)) {
         return 0;
     }
     pObject = Analog_Input_Object(rpdata->object_instance);
@@ -1227,8 +1227,7 @@ int Analog_Value_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
     if (rpdata == NULL) {
         return 0;
     }
-    if ((rpdata->application_data == NULL) ||
-        (rpdata->application_data_len == 0)) {
+    if (rpdata->application_data_len == 0) {
         return 0;
     }
     CurrentAV = Analog_Value_Object(rpdata->object_instance);
@@ -929,8 +929,7 @@ int Binary_Input_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
     int apdu_size = 0;
 #endif
 
-    if ((rpdata == NULL) || (rpdata->application_data == NULL) ||
-        (rpdata->application_data_len == 0)) {
+    if ((rpdata == NULL) || (rpdata->application_data_len == 0)) {
         return 0;
     }
     if (!(pObject = Binary_Input_Object(rpdata->object_instance))) {
@@ -1285,62 +1285,81 @@ rr_info_function Device_Objects_RR_Info(BACNET_OBJECT_TYPE object_type)
     return (pObject != NULL ? pObject->Object_RR_Info : NULL);
 }
 
-/** For a given object type, returns the special property list.
- * This function is used for ReadPropertyMultiple calls which want
- * just Required, just Optional, or All properties.
- * @ingroup ObjIntf
- *
- * @param object_type [in] The desired BACNET_OBJECT_TYPE whose properties
- *            are to be listed.
- * @param pPropertyList [out] Reference to the structure which will, on return,
- *            list, separately, the Required, Optional, and Proprietary object
- *            properties with their counts.
+/* number of object types with property lists kept in the index */
+#ifndef DEVICE_PROPERTY_LIST_INDEX_SIZE
+#define DEVICE_PROPERTY_LIST_INDEX_SIZE 32
+#endif
+/* property lists with counts and member bitsets, by object type */
+static struct device_property_list_index {
+    BACNET_OBJECT_TYPE object_type;
+    struct property_list_index_t index;
+} Property_List_Index[DEVICE_PROPERTY_LIST_INDEX_SIZE];
+
+/**
+ * @brief Get the indexed property lists for an object.
+ *  The index for the object type is rebuilt only when the object
+ *  returns different property lists than were last indexed.
+ * @param object_type [in] The desired BACNET_OBJECT_TYPE
+ * @param object_instance [in] The object instance number
+ * @return the property list index for the object
  */
-void Device_Objects_Property_List(
-    BACNET_OBJECT_TYPE object_type,
-    uint32_t object_instance,
-    struct special_property_list_t *pPropertyList)
+static const struct property_list_index_t *Device_Objects_Property_List_Index(
+    BACNET_OBJECT_TYPE object_type, uint32_t object_instance)
 {
     struct object_functions *pObject = NULL;
+    struct device_property_list_index *entry = NULL;
+    const int32_t *pRequired = NULL;
+    const int32_t *pOptional = NULL;
+    const int32_t *pProprietary = NULL;
     const int32_t *proprietary_property_list = NULL;
 
-    (void)object_instance;
-    pPropertyList->Required.pList = NULL;
-    pPropertyList->Optional.pList = NULL;
-    pPropertyList->Proprietary.pList = NULL;
-
     /* If we can find an entry for the required object type
      * and there is an Object_List_RPM fn ptr then call it
-     * to populate the pointers to the individual list counters.
+     * to populate the pointers to the individual lists.
      */
-
     pObject = Device_Object_Functions_Find(object_type);
     if ((pObject != NULL) && (pObject->Object_RPM_List != NULL)) {
-        pObject->Object_RPM_List(
-            &pPropertyList->Required.pList, &pPropertyList->Optional.pList,
-            &pPropertyList->Proprietary.pList);
+        pObject->Object_RPM_List(&pRequired, &pOptional, &pProprietary);
     }
-
-    /* Fetch the counts if available otherwise zero them */
-    pPropertyList->Required.count = pPropertyList->Required.pList == NULL
-        ? 0
-        : property_list_count(pPropertyList->Required.pList);
-
-    pPropertyList->Optional.count = pPropertyList->Optional.pList == NULL
-        ? 0
-        : property_list_count(pPropertyList->Optional.pList);
-
     if (Property_List_Proprietary_Callback) {
         if (Property_List_Proprietary_Callback(
                 object_type, object_instance, &proprietary_property_list)) {
-            pPropertyList->Proprietary.pList = proprietary_property_list;
+            pProprietary = proprietary_property_list;
         }
     }
-    pPropertyList->Proprietary.count = pPropertyList->Proprietary.pList == NULL
-        ? 0
-        : property_list_count(pPropertyList->Proprietary.pList);
+    entry = &Property_List_Index
+        [(unsigned)object_type % DEVICE_PROPERTY_LIST_INDEX_SIZE];
+    if ((entry->object_type != object_type) ||
+        !property_list_index_same(
+            &entry->index, pRequired, pOptional, pProprietary)) {
+        entry->object_type = object_type;
+        property_list_index_init(
+            &entry->index, pRequired, pOptional, pProprietary);
+    }
 
-    return;
+    return &entry->index;
+}
+
+/** For a given object type, returns the special property list.
+ * This function is used for ReadPropertyMultiple calls which want
+ * just Required, just Optional, or All properties.
+ * @ingroup ObjIntf
+ *
+ * @param object_type [in] The desired BACNET_OBJECT_TYPE whose properties
+ *            are to be listed.
+ * @param pPropertyList [out] Reference to the structure which will, on return,
+ *            list, separately, the Required, Optional, and Proprietary object
+ *            properties with their counts.
+ */
+void Device_Objects_Property_List(
+    BACNET_OBJECT_TYPE object_type,
+    uint32_t object_instance,
+    struct special_property_list_t *pPropertyList)
+{
+    const struct property_list_index_t *index;
+
+    index = Device_Objects_Property_List_Index(object_type, object_instance);
+    *pPropertyList = index->Lists;
 }
 
 /**
@@ -1524,21 +1543,11 @@ bool Device_Objects_Property_List_Member(
     uint32_t object_instance,
     BACNET_PROPERTY_ID object_property)
 {
-    bool found = false;
-    struct special_property_list_t property_list = { 0 };
+    const struct property_list_index_t *index;
 
-    Device_Objects_Property_List(object_type, object_instance, &property_list);
-    found = property_list_member(property_list.Required.pList, object_property);
-    if (!found) {
-        found =
-            property_list_member(property_list.Optional.pList, object_property);
-    }
-    if (!found) {
-        found = property_list_member(
-            property_list.Proprietary.pList, object_property);
-    }
+    index = Device_Objects_Property_List_Index(object_type, object_instance);
 
-    return found;
+    return property_list_index_member(index, object_property);
 }
 
 /* note: you really only need to define variables for
@@ -3087,8 +3096,7 @@ int Device_Read_Property_Local(BACNET_READ_PROPERTY_DATA *rpdata)
     struct object_functions *pObject = NULL;
     uint16_t apdu_max = 0;
 
-    if ((rpdata == NULL) || (rpdata->application_data == NULL) ||
-        (rpdata->application_data_len == 0)) {
+    if ((rpdata == NULL) || (rpdata->application_data_len == 0)) {
         return 0;
     }
     apdu = rpdata->application_data;
@@ -3359,8 +3367,7 @@ static int Read_Property_Common(
     struct special_property_list_t property_list;
 #endif
 
-    if ((rpdata == NULL) || (rpdata->application_data == NULL) ||
-        (rpdata->application_data_len == 0)) {
+    if ((rpdata == NULL) || (rpdata->application_data_len == 0)) {
         return 0;
     }
     apdu = rpdata->application_data;
@@ -3385,7 +3392,12 @@ static int Read_Property_Common(
             Device_Property_Proprietary_Member(
                 rpdata->object_type, rpdata->object_instance,
                 rpdata->object_property)) {
-            apdu_len = Read_Property_Proprietary_Callback(rpdata);
+            if (apdu) {
+                apdu_len = Read_Property_Proprietary_Callback(rpdata);
+            } else {
+                /* the callback may not support the size query mode */
+                apdu_len = 0;
+            }
         } else {
             if (pObject->Object_Read_Property) {
                 apdu_len = pObject->Object_Read_Property(rpdata);
@@ -551,11 +551,23 @@ DEVICE_OBJECT_DATA *Get_Routed_Device_Object(int idx);
 BACNET_STACK_EXPORT
 BACNET_ADDRESS *Get_Routed_Device_Address(int idx);
 BACNET_STACK_EXPORT
+bool Routed_Device_Set_Address(uint16_t idx, const BACNET_ADDRESS *address);
+BACNET_STACK_EXPORT
 void Routed_Device_Get_My_Address(BACNET_ADDRESS *my_address);
 BACNET_STACK_EXPORT
+int Routed_Device_Instance_Index(uint32_t object_instance);
+BACNET_STACK_EXPORT
+int Routed_Device_Address_Index(uint8_t address_len, const uint8_t *mac_adress);
+BACNET_STACK_EXPORT
 bool Routed_Device_Address_Lookup(
     int idx, uint8_t address_len, const uint8_t *mac_adress);
 BACNET_STACK_EXPORT
+bool Routed_Device_Find_Next(
+    const BACNET_ADDRESS *dest,
+    const int32_t *DNET_list,
+    int *cursor,
+    uint16_t *device_index);
+BACNET_STACK_EXPORT
 bool Routed_Device_GetNext(
     const BACNET_ADDRESS *dest, const int32_t *DNET_list, int *cursor);
 BACNET_STACK_EXPORT
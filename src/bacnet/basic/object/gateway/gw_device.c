@@ -9,6 +9,7 @@
  */
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 /* BACnet Stack defines - first */
 #include "bacnet/bacdef.h"
@@ -63,29 +64,240 @@ bool Routed_Device_Write_Property_Local(BACNET_WRITE_PROPERTY_DATA *wp_data);
  * and extending the regular Device Object functionality.
  ****************************************************************************/
 
-/** Model the gateway as the main Device, with (two) remote
- * Devices that are reached via its routing capabilities.
+/* The Device table is kept in blocks that are allocated when the first
+   Device of the block is added, so that a gateway configured for many
+   virtual Devices only pays for the ones it manages.  Devices never move,
+   so pointers from Get_Routed_Device_Object() remain valid. */
+#ifndef ROUTED_DEVICE_BLOCK_SIZE
+#if (MAX_NUM_DEVICES < 16)
+#define ROUTED_DEVICE_BLOCK_SIZE MAX_NUM_DEVICES
+#else
+#define ROUTED_DEVICE_BLOCK_SIZE 16
+#endif
+#endif
+#define ROUTED_DEVICE_BLOCKS                           \
+    ((MAX_NUM_DEVICES + ROUTED_DEVICE_BLOCK_SIZE - 1) / \
+     ROUTED_DEVICE_BLOCK_SIZE)
+/* marks an unused slot in the lookup hash tables */
+#define ROUTED_DEVICE_HASH_EMPTY UINT16_MAX
+
+/** Model the gateway as the main Device, with remote Devices
+ * that are reached via its routing capabilities.
+ * The first block, which holds the gateway, is always present.
  */
-DEVICE_OBJECT_DATA Devices[MAX_NUM_DEVICES];
+static DEVICE_OBJECT_DATA Device_Block_Gateway[ROUTED_DEVICE_BLOCK_SIZE];
+static DEVICE_OBJECT_DATA *Device_Blocks[ROUTED_DEVICE_BLOCKS] = {
+    Device_Block_Gateway
+};
 /** Keep track of the number of managed devices, including the gateway */
-uint16_t Num_Managed_Devices = 0;
+static uint16_t Num_Managed_Devices = 0;
 /** Which Device entry are we currently managing.
  * Since we are not using actual class objects here, the best we can do is
  * keep this local variable which notes which of the Devices the current
  * request is addressing.  Should default to 0, the main gateway Device.
  */
-uint16_t iCurrent_Device_Idx = 0;
+static uint16_t iCurrent_Device_Idx = 0;
+/* Open addressing hash tables of Device indexes keyed by the Device
+   instance and by the virtual MAC address.  Since the Device data is
+   handed out by pointer, the tables are rebuilt on the next lookup
+   after anything could have changed a key. */
+static uint16_t *Instance_Hash_Table;
+static uint16_t *Address_Hash_Table;
+static unsigned Hash_Table_Size;
+static bool Hash_Table_Stale = true;
+
+/**
+ * @brief Get the Device data at the given index
+ * @param idx - index into the Device table
+ * @return pointer to the Device data, or NULL if not allocated
+ */
+static DEVICE_OBJECT_DATA *Routed_Device_Data(uint16_t idx)
+{
+    DEVICE_OBJECT_DATA *block;
+
+    if (idx >= MAX_NUM_DEVICES) {
+        return NULL;
+    }
+    block = Device_Blocks[idx / ROUTED_DEVICE_BLOCK_SIZE];
+    if (!block) {
+        return NULL;
+    }
+
+    return &block[idx % ROUTED_DEVICE_BLOCK_SIZE];
+}
+
+/**
+ * @brief Make sure the block holding the given index is allocated
+ * @param idx - index into the Device table
+ * @return true if the Device data at the index exists
+ */
+static bool Routed_Device_Block_Alloc(uint16_t idx)
+{
+    unsigned block;
+
+    if (idx >= MAX_NUM_DEVICES) {
+        return false;
+    }
+    block = idx / ROUTED_DEVICE_BLOCK_SIZE;
+    if (!Device_Blocks[block]) {
+        Device_Blocks[block] =
+            calloc(ROUTED_DEVICE_BLOCK_SIZE, sizeof(DEVICE_OBJECT_DATA));
+    }
+
+    return Device_Blocks[block] != NULL;
+}
+
+/**
+ * @brief Get the currently selected Device data, which always exists
+ * @return pointer to the current Device data
+ */
+static DEVICE_OBJECT_DATA *Routed_Device_Current(void)
+{
+    return &Device_Blocks[iCurrent_Device_Idx / ROUTED_DEVICE_BLOCK_SIZE]
+                         [iCurrent_Device_Idx % ROUTED_DEVICE_BLOCK_SIZE];
+}
+
+static unsigned Routed_Device_Instance_Hash(uint32_t instance)
+{
+    /* Knuth multiplicative hash */
+    return (unsigned)((instance * 2654435761UL) & 0xFFFFFFFFUL);
+}
+
+static unsigned Routed_Device_Address_Hash(uint8_t len, const uint8_t *mac)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261UL;
+    uint8_t i;
+
+    hash = (hash ^ len) * 16777619UL;
+    for (i = 0; i < len; i++) {
+        hash = (hash ^ mac[i]) * 16777619UL;
+    }
+
+    return (unsigned)(hash ^ (hash >> 16));
+}
+
+static void Routed_Device_Hash_Insert(
+    uint16_t *table, unsigned hash, uint16_t idx)
+{
+    unsigned mask = Hash_Table_Size - 1;
+    unsigned slot = hash & mask;
+
+    while (table[slot] != ROUTED_DEVICE_HASH_EMPTY) {
+        slot = (slot + 1) & mask;
+    }
+    table[slot] = idx;
+}
+
+/**
+ * @brief Rebuild the lookup hash tables when they are out of date
+ * @return true if the hash tables can be used for lookups
+ */
+static bool Routed_Device_Hash_Update(void)
+{
+    unsigned size = 16;
+    uint16_t *instance_table, *address_table;
+    DEVICE_OBJECT_DATA *pDev;
+    uint16_t idx;
+
+    if (!Hash_Table_Stale) {
+        return Hash_Table_Size > 0;
+    }
+    /* keep the tables at most half full */
+    while (size < (2U * Num_Managed_Devices)) {
+        size *= 2;
+    }
+    if (size != Hash_Table_Size) {
+        instance_table = calloc(size, sizeof(uint16_t));
+        address_table = calloc(size, sizeof(uint16_t));
+        if (!instance_table || !address_table) {
+            free(instance_table);
+            free(address_table);
+            return false;
+        }
+        free(Instance_Hash_Table);
+        free(Address_Hash_Table);
+        Instance_Hash_Table = instance_table;
+        Address_Hash_Table = address_table;
+        Hash_Table_Size = size;
+    }
+    memset(Instance_Hash_Table, 0xFF, size * sizeof(uint16_t));
+    memset(Address_Hash_Table, 0xFF, size * sizeof(uint16_t));
+    for (idx = 0; idx < Num_Managed_Devices; idx++) {
+        pDev = Routed_Device_Data(idx);
+        Routed_Device_Hash_Insert(
+            Instance_Hash_Table,
+            Routed_Device_Instance_Hash(pDev->bacObj.Object_Instance_Number),
+            idx);
+        Routed_Device_Hash_Insert(
+            Address_Hash_Table,
+            Routed_Device_Address_Hash(
+                pDev->bacDevAddr.len, pDev->bacDevAddr.adr),
+            idx);
+    }
+    Hash_Table_Stale = false;
+
+    return true;
+}
+
+/**
+ * @brief Find the first Device at or after the starting index with the
+ *  given virtual MAC address, without changing the current Device.
+ * @param len - length of the MAC address
+ * @param mac - MAC address
+ * @param start - first index to consider
+ * @return index of the Device, or -1 if not found
+ */
+static int Routed_Device_Address_Find(
+    uint8_t len, const uint8_t *mac, uint16_t start)
+{
+    DEVICE_OBJECT_DATA *pDev;
+    unsigned mask, slot;
+    uint16_t idx;
+    int found = -1;
+
+    if (Routed_Device_Hash_Update()) {
+        mask = Hash_Table_Size - 1;
+        slot = Routed_Device_Address_Hash(len, mac) & mask;
+        while ((idx = Address_Hash_Table[slot]) != ROUTED_DEVICE_HASH_EMPTY) {
+            pDev = Routed_Device_Data(idx);
+            if ((idx >= start) && ((found < 0) || (idx < found)) &&
+                (pDev->bacDevAddr.len == len) &&
+                (memcmp(pDev->bacDevAddr.adr, mac, len) == 0)) {
+                found = idx;
+            }
+            slot = (slot + 1) & mask;
+        }
+    } else {
+        for (idx = start; idx < Num_Managed_Devices; idx++) {
+            pDev = Routed_Device_Data(idx);
+            if (memcmp(pDev->bacDevAddr.adr, mac, len) == 0) {
+                found = idx;
+                break;
+            }
+        }
+    }
+
+    return found;
+}
 
 /** Reset the routed Device table before rebuilding the gateway/virtual list. */
 void Routed_Device_Table_Reset(void)
 {
-    memset(&Devices[0], 0, sizeof(Devices));
+    unsigned block;
+
+    memset(Device_Block_Gateway, 0, sizeof(Device_Block_Gateway));
+    for (block = 1; block < ROUTED_DEVICE_BLOCKS; block++) {
+        free(Device_Blocks[block]);
+        Device_Blocks[block] = NULL;
+    }
     Num_Managed_Devices = 0;
     iCurrent_Device_Idx = 0;
+    Hash_Table_Stale = true;
 }
 
 /** Get the current routed device object index.
- * @return Index of the currently active routed device in Devices[] array
+ * @return Index of the currently active routed device in the Device table
  */
 uint16_t Routed_Device_Object_Index(void)
 {
@@ -115,7 +327,9 @@ bool Set_Routed_Device_Object_Index(uint16_t idx)
 
         return false;
     }
-
+    if (!Routed_Device_Block_Alloc(idx)) {
+        return false;
+    }
     iCurrent_Device_Idx = idx;
 
     return true;
@@ -125,12 +339,12 @@ bool Set_Routed_Device_Object_Index(uint16_t idx)
  * found in device.c
  */
 
-/** Add a Device to our table of Devices[].
+/** Add a Device to our table of Devices.
  * The first entry must be the gateway device.
  * @param Object_Instance [in] Set the new Device to this instance number.
  * @param sObject_Name [in] Use this Object Name for the Device.
  * @param sDescription [in] Set this Description for the Device.
- * @return The index of this instance in the Devices[] array, or UINT16_MAX if
+ * @return The index of this instance in the Device table, or UINT16_MAX if
  *         there isn't enough room to add this Device.
  */
 uint16_t Add_Routed_Device(
@@ -139,10 +353,11 @@ uint16_t Add_Routed_Device(
     const char *sDescription)
 {
     int i = Num_Managed_Devices;
-    if (i < MAX_NUM_DEVICES) {
-        DEVICE_OBJECT_DATA *pDev = &Devices[i];
+    if ((i < MAX_NUM_DEVICES) && Routed_Device_Block_Alloc(i)) {
+        DEVICE_OBJECT_DATA *pDev = Routed_Device_Data(i);
         Num_Managed_Devices++;
         iCurrent_Device_Idx = i;
+        Hash_Table_Stale = true;
         pDev->bacObj.mObject_Type = OBJECT_DEVICE;
         pDev->bacObj.Object_Instance_Number = Object_Instance;
         if (sObject_Name != NULL) {
@@ -175,30 +390,31 @@ uint16_t Add_Routed_Device(
 }
 
 /** Return the Device Object descriptive data for the indicated entry.
- * @param idx [in] Index into Devices[] array being requested.
+ * @param idx [in] Index into the Device table being requested.
  *                 0 is for the main, gateway Device entry.
  *                 -1 is a special case meaning "whichever iCurrent_Device_Idx
  *                 is currently set to"
  *                 If valid idx, will set iCurrent_Device_Idx with the idx
  * @return Pointer to the requested Device Object data, or NULL if the idx
  *         is for an invalid row entry (eg, after the last good Device).
+ * @note The instance number and address of the Device may be changed
+ *  through the pointer returned for a valid idx.
  */
 DEVICE_OBJECT_DATA *Get_Routed_Device_Object(int idx)
 {
     if (idx == -1) {
-        return &Devices[iCurrent_Device_Idx];
-    } else if (
-        (idx >= 0) &&
-        (idx < BACNET_MIN(MAX_NUM_DEVICES, Num_Managed_Devices))) {
+        return Routed_Device_Current();
+    } else if ((idx >= 0) && (idx < Num_Managed_Devices)) {
         iCurrent_Device_Idx = idx;
-        return &Devices[idx];
+        Hash_Table_Stale = true;
+        return Routed_Device_Data(idx);
     } else {
         return NULL;
     }
 }
 
 /** Return the BACnet address for the indicated entry.
- * @param idx [in] Index into Devices[] array being requested.
+ * @param idx [in] Index into the Device table being requested.
  *                 0 is for the main, gateway Device entry.
  *                 -1 is a special case meaning "whichever iCurrent_Device_Idx
  *                 is currently set to"
@@ -209,17 +425,34 @@ DEVICE_OBJECT_DATA *Get_Routed_Device_Object(int idx)
 BACNET_ADDRESS *Get_Routed_Device_Address(int idx)
 {
     if (idx == -1) {
-        return &Devices[iCurrent_Device_Idx].bacDevAddr;
-    } else if (
-        (idx >= 0) &&
-        (idx < BACNET_MIN(MAX_NUM_DEVICES, Num_Managed_Devices))) {
+        return &Routed_Device_Current()->bacDevAddr;
+    } else if ((idx >= 0) && (idx < Num_Managed_Devices)) {
         iCurrent_Device_Idx = idx;
-        return &Devices[idx].bacDevAddr;
+        Hash_Table_Stale = true;
+        return &Routed_Device_Data(idx)->bacDevAddr;
     } else {
         return NULL;
     }
 }
 
+/** Set the BACnet address of the indicated entry, which is
+ * normally the virtual network number and MAC of a routed Device.
+ * Does not change the current Device.
+ * @param idx [in] Index into the Device table.
+ * @param address [in] The BACnet address of the Device.
+ * @return True if the address was set, or False if idx is invalid.
+ */
+bool Routed_Device_Set_Address(uint16_t idx, const BACNET_ADDRESS *address)
+{
+    if ((idx >= Num_Managed_Devices) || (address == NULL)) {
+        return false;
+    }
+    bacnet_address_copy(&Routed_Device_Data(idx)->bacDevAddr, address);
+    Hash_Table_Stale = true;
+
+    return true;
+}
+
 /** Get the currently active BACnet address.
  * This is an implementation of the datalink_get_my_address() template for
  * devices with routing.
@@ -231,18 +464,69 @@ void Routed_Device_Get_My_Address(BACNET_ADDRESS *my_address)
 {
     if (my_address) {
         memcpy(
-            my_address, &Devices[iCurrent_Device_Idx].bacDevAddr,
+            my_address, &Routed_Device_Current()->bacDevAddr,
             sizeof(BACNET_ADDRESS));
     }
 }
 
+/** Find the index of the Device with the given instance number.
+ * Does not change the current Device.
+ * @param object_instance [in] Device Object instance number.
+ * @return Index into the Device table, or -1 if not found.
+ */
+int Routed_Device_Instance_Index(uint32_t object_instance)
+{
+    DEVICE_OBJECT_DATA *pDev;
+    unsigned mask, slot;
+    uint16_t idx;
+    int found = -1;
+
+    if (Routed_Device_Hash_Update()) {
+        mask = Hash_Table_Size - 1;
+        slot = Routed_Device_Instance_Hash(object_instance) & mask;
+        while ((idx = Instance_Hash_Table[slot]) != ROUTED_DEVICE_HASH_EMPTY) {
+            pDev = Routed_Device_Data(idx);
+            if ((pDev->bacObj.Object_Instance_Number == object_instance) &&
+                ((found < 0) || (idx < found))) {
+                found = idx;
+            }
+            slot = (slot + 1) & mask;
+        }
+    } else {
+        for (idx = 0; idx < Num_Managed_Devices; idx++) {
+            pDev = Routed_Device_Data(idx);
+            if (pDev->bacObj.Object_Instance_Number == object_instance) {
+                found = idx;
+                break;
+            }
+        }
+    }
+
+    return found;
+}
+
+/** Find the index of the routed Device with the given virtual MAC address.
+ * Does not change the current Device.
+ * @param address_len [in] Length of the mac_adress[] field.
+ * @param mac_adress [in] The virtual MAC address of a routed Device.
+ * @return Index into the Device table, or -1 if not found.
+ */
+int Routed_Device_Address_Index(uint8_t address_len, const uint8_t *mac_adress)
+{
+    if ((address_len == 0) || (mac_adress == NULL)) {
+        return -1;
+    }
+
+    return Routed_Device_Address_Find(address_len, mac_adress, 0);
+}
+
 /** See if the Gateway or Routed Device at the given idx matches
  * the given MAC address.
  * Has the desirable side-effect of setting iCurrent_Device_Idx to the
  * given idx if a match is found, for use in the subsequent routing handling
  * functions here.
  *
- * @param idx [in] Index into Devices[] array being requested.
+ * @param idx [in] Index into the Device table being requested.
  *                 0 is for the main, gateway Device entry.
  * @param address_len [in] Length of the mac_adress[] field.
  *         If 0, then this is a MAC broadcast.  Otherwise, size is determined
@@ -259,9 +543,8 @@ bool Routed_Device_Address_Lookup(int idx, uint8_t dlen, const uint8_t *dadr)
     DEVICE_OBJECT_DATA *pDev;
     int i;
 
-    if ((idx >= 0) &&
-        (idx < BACNET_MIN(MAX_NUM_DEVICES, Num_Managed_Devices))) {
-        pDev = &Devices[idx];
+    if ((idx >= 0) && (idx < Num_Managed_Devices)) {
+        pDev = Routed_Device_Data(idx);
         if (dlen == 0) {
             /* Automatic match */
             iCurrent_Device_Idx = idx;
@@ -283,10 +566,9 @@ bool Routed_Device_Address_Lookup(int idx, uint8_t dlen, const uint8_t *dadr)
 }
 
 /** Find the next Gateway or Routed Device at the given MAC address,
- * starting the search at the "cursor".
- * Has the desirable side-effect of setting internal iCurrent_Device_Idx
- * if a match is found, for use in the subsequent routing handling
- * functions.
+ * starting the search at the "cursor", without changing the current Device.
+ * Devices on our virtual DNET are found by their virtual MAC address
+ * using a hash table lookup.
  *
  * @param dest [in] The BACNET_ADDRESS of the message's destination.
  *         If the Length of the mac_adress[] field is 0, then this is a
@@ -294,42 +576,44 @@ bool Routed_Device_Address_Lookup(int idx, uint8_t dlen, const uint8_t *dadr)
  * and 2 for MSTP).
  * @param DNET_list [in] List of our reachable downstream BACnet Network
  * numbers. Normally just one valid entry; terminated with a -1 value.
- * @param cursor [in,out] The concept of the cursor is that it is a starting
- *         "hint" for the search; on return, it is updated to provide
- * the cursor value to use with a subsequent GetNext call, or it equals -1 if
- * there are no further matches. Set it to 0 on entry to access the main,
- * gateway Device entry, or to start looping through the routed devices.
- *         Otherwise, its returned value is implementation-dependent and the
- *         calling function should not alter or interpret it.
+ * @param cursor [in,out] The search cursor, as for Routed_Device_GetNext().
+ * @param device_index [out] The index of the matching Device.
  *
- * @return True if the MAC addresses match (or if BACNET_BROADCAST_NETWORK and
- *         the dest->len is 0, meaning MAC bcast, so it's an automatic
- * match). Else False if no match or invalid idx is given; the cursor will be
- * returned as -1 in these cases.
+ * @return True if a matching Device was found, else False; the cursor will
+ * be returned as -1 in this case.
  */
-bool Routed_Device_GetNext(
-    const BACNET_ADDRESS *dest, const int32_t *DNET_list, int *cursor)
+bool Routed_Device_Find_Next(
+    const BACNET_ADDRESS *dest,
+    const int32_t *DNET_list,
+    int *cursor,
+    uint16_t *device_index)
 {
     int dnet = DNET_list[0]; /* Get the DNET of our virtual network */
     int idx = *cursor;
-    bool bSuccess = false;
+    int found = -1;
 
-    if ((idx < 0) ||
-        (idx >= BACNET_MIN(MAX_NUM_DEVICES, Num_Managed_Devices))) {
+    if ((idx < 0) || (idx >= Num_Managed_Devices)) {
         /* The next index will be out of range.
            Eg, last call to GetNext may have been the last successful one.*/
         idx = -1;
     } else if (dest->net == BACNET_BROADCAST_NETWORK) {
         /* For BACnet broadcasts, all Devices get a chance at it. */
         /* Just take the entry indexed by the cursor */
-        bSuccess = Routed_Device_Address_Lookup(idx++, dest->len, dest->adr);
+        if ((dest->len == 0) ||
+            (memcmp(Routed_Device_Data(idx)->bacDevAddr.adr, dest->adr,
+                    dest->len) == 0)) {
+            found = idx;
+        }
+        idx++;
     } else if (dest->net == 0) {
         /* See if it's for the main Gateway Device,
            because there's no routing info. */
-        /* Handle like a normal, non-routed access of the Gateway Device.
-           But first, make sure our internal access is pointing at
-           that Device in our table by telling it "no routing info" : */
-        bSuccess = Routed_Device_Address_Lookup(0, dest->len, dest->adr);
+        /* Handle like a normal, non-routed access of the Gateway Device. */
+        if ((dest->len == 0) ||
+            (memcmp(Routed_Device_Data(0)->bacDevAddr.adr, dest->adr,
+                    dest->len) == 0)) {
+            found = 0;
+        }
         /* Next step: no more matches: */
         idx = -1;
     } else if (dest->net == dnet) {
@@ -341,23 +625,68 @@ bool Routed_Device_GetNext(
             /* Step over this case (starting point) */
             idx = 1;
         }
-        while (idx < BACNET_MIN(MAX_NUM_DEVICES, Num_Managed_Devices)) {
-            bSuccess =
-                Routed_Device_Address_Lookup(idx++, dest->len, dest->adr);
-            if (bSuccess) {
-                /* We don't need to keep looking */
-                break;
-            }
+        if (dest->len == 0) {
+            found = idx;
+        } else {
+            found = Routed_Device_Address_Find(dest->len, dest->adr, idx);
+        }
+        if (found >= 0) {
+            idx = found + 1;
         }
     }
-    if (!bSuccess) {
-        *cursor = -1;
-    } else if (idx == BACNET_MIN(MAX_NUM_DEVICES, Num_Managed_Devices)) {
-        /* No more to GetNext */
+    if (found < 0) {
         *cursor = -1;
     } else {
-        *cursor = idx;
+        if (device_index) {
+            *device_index = (uint16_t)found;
+        }
+        if (idx >= Num_Managed_Devices) {
+            /* No more to GetNext */
+            *cursor = -1;
+        } else {
+            *cursor = idx;
+        }
+    }
+
+    return found >= 0;
+}
+
+/** Find the next Gateway or Routed Device at the given MAC address,
+ * starting the search at the "cursor".
+ * Has the desirable side-effect of setting internal iCurrent_Device_Idx
+ * if a match is found, for use in the subsequent routing handling
+ * functions.
+ *
+ * @param dest [in] The BACNET_ADDRESS of the message's destination.
+ *         If the Length of the mac_adress[] field is 0, then this is a
+ * MAC broadcast.  Otherwise, size is determined by the DLL type (eg, 6 for BIP
+ * and 2 for MSTP).
+ * @param DNET_list [in] List of our reachable downstream BACnet Network
+ * numbers. Normally just one valid entry; terminated with a -1 value.
+ * @param cursor [in,out] The concept of the cursor is that it is a starting
+ *         "hint" for the search; on return, it is updated to provide
+ * the cursor value to use with a subsequent GetNext call, or it equals -1 if
+ * there are no further matches. Set it to 0 on entry to access the main,
+ * gateway Device entry, or to start looping through the routed devices.
+ *         Otherwise, its returned value is implementation-dependent and the
+ *         calling function should not alter or interpret it.
+ *
+ * @return True if the MAC addresses match (or if BACNET_BROADCAST_NETWORK and
+ *         the dest->len is 0, meaning MAC bcast, so it's an automatic
+ * match). Else False if no match or invalid idx is given; the cursor will be
+ * returned as -1 in these cases.
+ */
+bool Routed_Device_GetNext(
+    const BACNET_ADDRESS *dest, const int32_t *DNET_list, int *cursor)
+{
+    uint16_t idx = 0;
+    bool bSuccess;
+
+    bSuccess = Routed_Device_Find_Next(dest, DNET_list, cursor, &idx);
+    if (bSuccess) {
+        iCurrent_Device_Idx = idx;
     }
+
     return bSuccess;
 }
 
@@ -399,7 +728,7 @@ bool Routed_Device_Is_Valid_Network(uint16_t dest_net, const int32_t *DNET_list)
 uint32_t Routed_Device_Index_To_Instance(unsigned index)
 {
     (void)index;
-    return Devices[iCurrent_Device_Idx].bacObj.Object_Instance_Number;
+    return Routed_Device_Current()->bacObj.Object_Instance_Number;
 }
 
 /**
@@ -411,13 +740,11 @@ uint32_t Routed_Device_Index_To_Instance(unsigned index)
  */
 static uint32_t Routed_Device_Instance_To_Index(uint32_t Instance_Number)
 {
-    int i;
+    int idx = Routed_Device_Instance_Index(Instance_Number);
 
-    for (i = 0; i < BACNET_MIN(MAX_NUM_DEVICES, Num_Managed_Devices); i++) {
-        if (Devices[i].bacObj.Object_Instance_Number == Instance_Number) {
-            /* Found Instance, so return the Device Index Number */
-            return i;
-        }
+    if (idx >= 0) {
+        /* Found Instance, so return the Device Index Number */
+        return (uint32_t)idx;
     }
 
     /* We did not find instance... so simply return an Index of 0
@@ -437,7 +764,7 @@ bool Routed_Device_Valid_Object_Instance_Number(uint32_t object_id)
     DEVICE_OBJECT_DATA *pDev = NULL;
 
     iCurrent_Device_Idx = Routed_Device_Instance_To_Index(object_id);
-    pDev = &Devices[iCurrent_Device_Idx];
+    pDev = Routed_Device_Current();
     if (pDev->bacObj.Object_Instance_Number == object_id) {
         valid = true;
     }
@@ -448,7 +775,7 @@ bool Routed_Device_Valid_Object_Instance_Number(uint32_t object_id)
 bool Routed_Device_Name(
     uint32_t object_instance, BACNET_CHARACTER_STRING *object_name)
 {
-    DEVICE_OBJECT_DATA *pDev = &Devices[iCurrent_Device_Idx];
+    DEVICE_OBJECT_DATA *pDev = Routed_Device_Current();
     if (object_instance == pDev->bacObj.Object_Instance_Number) {
         return characterstring_init_ansi(object_name, pDev->bacObj.Object_Name);
     }
@@ -467,7 +794,7 @@ int Routed_Device_Read_Property_Local(BACNET_READ_PROPERTY_DATA *rpdata)
     int apdu_len = 0; /* return value */
     BACNET_CHARACTER_STRING char_string;
     uint8_t *apdu = NULL;
-    DEVICE_OBJECT_DATA *pDev = &Devices[iCurrent_Device_Idx];
+    DEVICE_OBJECT_DATA *pDev = Routed_Device_Current();
 
     if ((rpdata == NULL) || (rpdata->application_data == NULL) ||
         (rpdata->application_data_len == 0)) {
@@ -561,7 +888,7 @@ bool Routed_Device_Write_Property_Local(BACNET_WRITE_PROPERTY_DATA *wp_data)
  */
 uint32_t Routed_Device_Object_Instance_Number(void)
 {
-    return Devices[iCurrent_Device_Idx].bacObj.Object_Instance_Number;
+    return Routed_Device_Current()->bacObj.Object_Instance_Number;
 }
 
 bool Routed_Device_Set_Object_Instance_Number(uint32_t object_id)
@@ -570,7 +897,8 @@ bool Routed_Device_Set_Object_Instance_Number(uint32_t object_id)
 
     if (object_id <= BACNET_MAX_INSTANCE) {
         /* Make the change and update the database revision */
-        Devices[iCurrent_Device_Idx].bacObj.Object_Instance_Number = object_id;
+        Routed_Device_Current()->bacObj.Object_Instance_Number = object_id;
+        Hash_Table_Stale = true;
         Routed_Device_Inc_Database_Revision();
     } else {
         status = false;
@@ -589,7 +917,7 @@ bool Routed_Device_Set_Object_Name(
     uint8_t encoding, const char *value, size_t length)
 {
     bool status = false; /*return value */
-    DEVICE_OBJECT_DATA *pDev = &Devices[iCurrent_Device_Idx];
+    DEVICE_OBJECT_DATA *pDev = Routed_Device_Current();
 
     if ((encoding == CHARACTER_UTF8) && (length < MAX_DEV_NAME_LEN)) {
         /* Make the change and update the database revision */
@@ -605,7 +933,7 @@ bool Routed_Device_Set_Object_Name(
 bool Routed_Device_Set_Description(const char *name, size_t length)
 {
     bool status = false; /*return value */
-    DEVICE_OBJECT_DATA *pDev = &Devices[iCurrent_Device_Idx];
+    DEVICE_OBJECT_DATA *pDev = Routed_Device_Current();
 
     if (length < MAX_DEV_DESC_LEN) {
         memmove(pDev->Description, name, length);
@@ -623,7 +951,7 @@ bool Routed_Device_Set_Description(const char *name, size_t length)
  */
 void Routed_Device_Inc_Database_Revision(void)
 {
-    DEVICE_OBJECT_DATA *pDev = &Devices[iCurrent_Device_Idx];
+    DEVICE_OBJECT_DATA *pDev = Routed_Device_Current();
     pDev->Database_Revision++;
 }
 
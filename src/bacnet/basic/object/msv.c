@@ -761,8 +761,7 @@ int Multistate_Value_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
     bool state = false;
     uint8_t *apdu = NULL;
 
-    if ((rpdata == NULL) || (rpdata->application_data == NULL) ||
-        (rpdata->application_data_len == 0)) {
+    if ((rpdata == NULL) || (rpdata->application_data_len == 0)) {
         return 0;
     }
     apdu = rpdata->application_data;
@@ -814,8 +813,7 @@ int Multistate_Value_Read_Property(BACNET_READ_PROPERTY_DATA *rpdata)
             break;
         case PROP_NUMBER_OF_STATES:
             apdu_len = encode_application_unsigned(
-                &apdu[apdu_len],
-                Multistate_Value_Max_States(rpdata->object_instance));
+                &apdu[0], Multistate_Value_Max_States(rpdata->object_instance));
             break;
         case PROP_STATE_TEXT:
             max_states = Multistate_Value_Max_States(rpdata->object_instance);
@@ -389,35 +389,52 @@ static uint8_t tokenizer_next_token(struct ubasic_tokenizer *tree)
 }
 /*---------------------------------------------------------------------------*/
 #if defined(UBASIC_VARIABLE_TYPE_STRING)
+static int8_t string_token_class(uint8_t token)
+{
+    int8_t si = -1;
+
+    if (token == UBASIC_TOKENIZER_EOL || token == UBASIC_TOKENIZER_ENDOFINPUT) {
+        si = 0;
+    } else if (
+        token == UBASIC_TOKENIZER_NUMBER ||
+        token == UBASIC_TOKENIZER_VARIABLE ||
+        token == UBASIC_TOKENIZER_FLOAT) {
+        si = 0; /* number or numeric var */
+    } else if (token == UBASIC_TOKENIZER_PLUS) {
+        /* do nothing */
+    } else if (token == UBASIC_TOKENIZER_STRING) {
+        si = 1;
+    } else if (
+        token >= UBASIC_TOKENIZER_STRINGVARIABLE &&
+        token <= UBASIC_TOKENIZER_CHR_STR) {
+        si = 1;
+    } else if (token > UBASIC_TOKENIZER_CHR_STR) {
+        si = 0; /* numeric function */
+    }
+
+    return si;
+}
+
 int8_t tokenizer_stringlookahead(struct ubasic_tokenizer *tree)
 {
     /* return 1 (true) if next 'defining' token is string not integer */
     const char *saveptr = tree->ptr;
     const char *savenextptr = tree->nextptr;
     uint8_t token = tree->current_token;
+    uint16_t pc = tree->pc;
     int8_t si = -1;
 
-    while (si == -1) {
-        if (token == UBASIC_TOKENIZER_EOL ||
-            token == UBASIC_TOKENIZER_ENDOFINPUT) {
-            si = 0;
-        } else if (
-            token == UBASIC_TOKENIZER_NUMBER ||
-            token == UBASIC_TOKENIZER_VARIABLE ||
-            token == UBASIC_TOKENIZER_FLOAT) {
-            si = 0; /* number or numeric var */
-        } else if (token == UBASIC_TOKENIZER_PLUS) {
-            /* do nothing */
-        } else if (token == UBASIC_TOKENIZER_STRING) {
-            si = 1;
-        } else if (
-            token >= UBASIC_TOKENIZER_STRINGVARIABLE &&
-            token <= UBASIC_TOKENIZER_CHR_STR) {
-            si = 1;
-        } else if (token > UBASIC_TOKENIZER_CHR_STR) {
-            si = 0; /* numeric function */
+    if (tree->code) {
+        while (si == -1) {
+            si = string_token_class(tree->code[pc].token);
+            if (pc < (tree->code_len - 1)) {
+                pc++;
+            }
         }
-
+        return si;
+    }
+    while (si == -1) {
+        si = string_token_class(token);
         token = tokenizer_next_token(tree);
     }
     tree->ptr = saveptr;
@@ -430,9 +447,186 @@ void tokenizer_init(struct ubasic_tokenizer *tree, const char *program)
 {
     tree->ptr = program;
     tree->prog = program;
+    tree->code = NULL;
+    tree->code_len = 0;
+    tree->pc = 0;
     tree->current_token = tokenizer_next_token(tree);
 }
 /*---------------------------------------------------------------------------*/
+/**
+ * @brief Load the token at the program counter of a compiled program
+ * @param tree - tokenizer data
+ */
+static void tokenizer_code_load(struct ubasic_tokenizer *tree)
+{
+    const struct ubasic_bytecode *code = &tree->code[tree->pc];
+
+    tree->current_token = code->token;
+    tree->ptr = tree->prog + code->offset;
+    if (tree->pc < (tree->code_len - 1)) {
+        tree->nextptr = tree->prog + code[1].offset;
+    } else {
+        tree->nextptr = tree->ptr;
+    }
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Copy the label of a compiled token
+ * @param program - program text
+ * @param code - compiled program
+ * @param index - index of the label token in the compiled program
+ * @param dest - buffer for the label
+ * @param len - size of the buffer
+ */
+static void tokenizer_code_label(
+    const char *program,
+    const struct ubasic_bytecode *code,
+    uint16_t index,
+    char *dest,
+    uint8_t len)
+{
+    struct ubasic_tokenizer tree = { 0 };
+
+    tree.prog = program;
+    tree.ptr = program + code[index].offset;
+    tree.nextptr = program + code[index + 1].offset;
+    tree.current_token = UBASIC_TOKENIZER_LABEL;
+    tokenizer_label(&tree, dest, len);
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Resolve the goto and gosub labels of a compiled program to the
+ *  index of their label definition, so that a jump does not have to scan
+ *  the program for the label. Labels that are not defined resolve to
+ *  the end of the program, which is where the label scan would end.
+ * @param program - program text
+ * @param code - compiled program
+ * @param code_len - number of tokens in the compiled program
+ */
+static void tokenizer_code_labels(
+    const char *program, struct ubasic_bytecode *code, uint16_t code_len)
+{
+    char label[UBASIC_LABEL_LEN_MAX] = { 0 };
+    char target[UBASIC_LABEL_LEN_MAX] = { 0 };
+    uint16_t i, j;
+
+    for (i = 1; i < code_len; i++) {
+        if ((code[i].token != UBASIC_TOKENIZER_LABEL) ||
+            ((code[i - 1].token != UBASIC_TOKENIZER_GOTO) &&
+             (code[i - 1].token != UBASIC_TOKENIZER_GOSUB))) {
+            continue;
+        }
+        tokenizer_code_label(program, code, i, label, sizeof(label));
+        code[i].value = code_len - 1;
+        for (j = 1; j < code_len; j++) {
+            if ((code[j].token == UBASIC_TOKENIZER_LABEL) &&
+                (code[j - 1].token == UBASIC_TOKENIZER_COLON)) {
+                tokenizer_code_label(program, code, j, target, sizeof(target));
+                if (strcmp(label, target) == 0) {
+                    code[i].value = j;
+                    break;
+                }
+            }
+        }
+    }
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Compile a program into bytecode: each token is scanned once,
+ *  and numbers, variable slots, and goto/gosub targets are decoded, so
+ *  that running the program does not have to scan the text again.
+ * @param program - program text, which must be kept while running the code
+ * @param code - buffer for the compiled program
+ * @param code_size - number of tokens that fit in the buffer
+ * @return number of tokens in the compiled program, or 0 if the program
+ *  does not fit in the buffer or is larger than the offsets can address
+ */
+uint16_t tokenizer_compile(
+    const char *program, struct ubasic_bytecode *code, uint16_t code_size)
+{
+    struct ubasic_tokenizer tree = { 0 };
+    UBASIC_VARIABLE_TYPE value;
+    uint16_t code_len = 0;
+
+    if (!program || !code) {
+        return 0;
+    }
+    tokenizer_init(&tree, program);
+    for (;;) {
+        if ((code_len >= code_size) || (code_len >= INT16_MAX) ||
+            ((tree.ptr - program) > UINT16_MAX)) {
+            return 0;
+        }
+        switch (tree.current_token) {
+            case UBASIC_TOKENIZER_NUMBER:
+                value = tokenizer_num(&tree);
+                break;
+            case UBASIC_TOKENIZER_INT:
+                value = tokenizer_int(&tree);
+                break;
+#if defined(UBASIC_VARIABLE_TYPE_FLOAT_AS_FIXEDPT_24_8) || \
+    defined(UBASIC_VARIABLE_TYPE_FLOAT_AS_FIXEDPT_22_10)
+            case UBASIC_TOKENIZER_FLOAT:
+                value = tokenizer_float(&tree);
+                break;
+#endif
+            case UBASIC_TOKENIZER_VARIABLE:
+#if defined(UBASIC_VARIABLE_TYPE_STRING)
+            case UBASIC_TOKENIZER_STRINGVARIABLE:
+#endif
+#if defined(UBASIC_VARIABLE_TYPE_ARRAY)
+            case UBASIC_TOKENIZER_ARRAYVARIABLE:
+#endif
+                value = tokenizer_variable_num(&tree);
+                break;
+            default:
+                value = 0;
+                break;
+        }
+        code[code_len].token = tree.current_token;
+        code[code_len].offset = (uint16_t)(tree.ptr - program);
+        code[code_len].value = value;
+        code_len++;
+        if (tree.current_token == UBASIC_TOKENIZER_ENDOFINPUT) {
+            break;
+        }
+        if (tree.current_token == UBASIC_TOKENIZER_ERROR) {
+            /* the scan can not continue past an error */
+            tree.ptr = program + strlen(program);
+            tree.current_token = UBASIC_TOKENIZER_ENDOFINPUT;
+        } else {
+            tokenizer_next(&tree);
+        }
+    }
+    tokenizer_code_labels(program, code, code_len);
+
+    return code_len;
+}
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Initialize the tokenizer to run a compiled program
+ * @param tree - tokenizer data
+ * @param program - program text that was compiled
+ * @param code - compiled program from tokenizer_compile()
+ * @param code_len - number of tokens in the compiled program
+ */
+void tokenizer_init_code(
+    struct ubasic_tokenizer *tree,
+    const char *program,
+    const struct ubasic_bytecode *code,
+    uint16_t code_len)
+{
+    if (!code || (code_len == 0)) {
+        tokenizer_init(tree, program);
+        return;
+    }
+    tree->prog = program;
+    tree->code = code;
+    tree->code_len = code_len;
+    tree->pc = 0;
+    tokenizer_code_load(tree);
+}
+/*---------------------------------------------------------------------------*/
 uint8_t tokenizer_token(struct ubasic_tokenizer *tree)
 {
     return tree->current_token;
@@ -443,6 +637,11 @@ void tokenizer_next(struct ubasic_tokenizer *tree)
     if (tokenizer_finished(tree)) {
         return;
     }
+    if (tree->code) {
+        tree->pc++;
+        tokenizer_code_load(tree);
+        return;
+    }
 
     tree->ptr = tree->nextptr;
 
@@ -460,6 +659,9 @@ UBASIC_VARIABLE_TYPE tokenizer_num(struct ubasic_tokenizer *tree)
     const char *c = tree->ptr;
     UBASIC_VARIABLE_TYPE rval = 0;
 
+    if (tree->code && (tree->current_token == UBASIC_TOKENIZER_NUMBER)) {
+        return tree->code[tree->pc].value;
+    }
     while (1) {
         if (*c < '0' || *c > '9') {
             break;
@@ -477,6 +679,10 @@ UBASIC_VARIABLE_TYPE tokenizer_int(struct ubasic_tokenizer *tree)
 {
     const char *c = tree->ptr;
     UBASIC_VARIABLE_TYPE rval = 0;
+
+    if (tree->code && (tree->current_token == UBASIC_TOKENIZER_INT)) {
+        return tree->code[tree->pc].value;
+    }
     if ((*c == '0') && (*(c + 1) == 'x' || *(c + 1) == 'X')) {
         c += 2;
         while (1) {
@@ -524,6 +730,9 @@ UBASIC_VARIABLE_TYPE tokenizer_int(struct ubasic_tokenizer *tree)
 /*---------------------------------------------------------------------------*/
 UBASIC_VARIABLE_TYPE tokenizer_float(struct ubasic_tokenizer *tree)
 {
+    if (tree->code && (tree->current_token == UBASIC_TOKENIZER_FLOAT)) {
+        return tree->code[tree->pc].value;
+    }
     return str_fixedpt(
         tree->ptr, tree->nextptr - tree->ptr, FIXEDPT_FBITS >> 1);
 }
@@ -598,6 +807,9 @@ void tokenizer_label(struct ubasic_tokenizer *tree, char *dest, uint8_t len)
 /*---------------------------------------------------------------------------*/
 bool tokenizer_finished(struct ubasic_tokenizer *tree)
 {
+    if (tree->code) {
+        return (tree->current_token == UBASIC_TOKENIZER_ENDOFINPUT);
+    }
     return (
         (*tree->ptr == 0) ||
         (tree->current_token == UBASIC_TOKENIZER_ENDOFINPUT));
@@ -606,6 +818,17 @@ bool tokenizer_finished(struct ubasic_tokenizer *tree)
 /*---------------------------------------------------------------------------*/
 uint8_t tokenizer_variable_num(struct ubasic_tokenizer *tree)
 {
+    if (tree->code &&
+        ((tree->current_token == UBASIC_TOKENIZER_VARIABLE)
+#if defined(UBASIC_VARIABLE_TYPE_STRING)
+         || (tree->current_token == UBASIC_TOKENIZER_STRINGVARIABLE)
+#endif
+#if defined(UBASIC_VARIABLE_TYPE_ARRAY)
+         || (tree->current_token == UBASIC_TOKENIZER_ARRAYVARIABLE)
+#endif
+             )) {
+        return (uint8_t)tree->code[tree->pc].value;
+    }
     if ((*tree->ptr >= 'a' && *tree->ptr <= 'z')) {
         return (((uint8_t)*tree->ptr) - 'a');
     }
@@ -620,13 +843,24 @@ uint8_t tokenizer_variable_num(struct ubasic_tokenizer *tree)
 
 uint16_t tokenizer_save_offset(struct ubasic_tokenizer *tree)
 {
+    if (tree->code) {
+        return tree->pc;
+    }
     return (tree->ptr - tree->prog);
 }
 
 void tokenizer_jump_offset(struct ubasic_tokenizer *tree, uint16_t offset)
 {
-    tree->ptr = (tree->prog + offset);
-    tree->current_token = tokenizer_next_token(tree);
+    if (tree->code) {
+        if (offset >= tree->code_len) {
+            offset = tree->code_len - 1;
+        }
+        tree->pc = offset;
+        tokenizer_code_load(tree);
+    } else {
+        tree->ptr = (tree->prog + offset);
+        tree->current_token = tokenizer_next_token(tree);
+    }
     while ((tree->current_token == UBASIC_TOKENIZER_EOL) &&
            !tokenizer_finished(tree)) {
         tokenizer_next(tree);
@@ -634,6 +868,21 @@ void tokenizer_jump_offset(struct ubasic_tokenizer *tree, uint16_t offset)
     return;
 }
 
+/**
+ * @brief Get the resolved jump target of a goto or gosub label
+ * @param tree - tokenizer data
+ * @return offset of the label definition for tokenizer_jump_offset(),
+ *  or -1 if the program is not compiled and the label must be searched
+ */
+int32_t tokenizer_label_target(struct ubasic_tokenizer *tree)
+{
+    if (tree->code && (tree->current_token == UBASIC_TOKENIZER_LABEL)) {
+        return tree->code[tree->pc].value;
+    }
+
+    return -1;
+}
+
 const char *tokenizer_name(UBASIC_VARIABLE_TYPE token)
 {
     const struct keyword_token *kt;
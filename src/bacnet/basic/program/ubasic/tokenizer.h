@@ -177,14 +177,38 @@ enum {
     /* */
 };
 
+/**
+ * One token of a compiled program: the token, where it starts in the
+ * program text, and its value decoded at compile time - the number,
+ * the variable slot, or for a goto/gosub label the index of the label
+ * definition that it jumps to.
+ */
+struct ubasic_bytecode {
+    UBASIC_VARIABLE_TYPE value;
+    uint16_t offset;
+    uint8_t token;
+};
+
 struct ubasic_tokenizer {
     const char *ptr;
     const char *nextptr;
     const char *prog;
     uint8_t current_token;
+    /* compiled program, or NULL when tokenizing the program text */
+    const struct ubasic_bytecode *code;
+    uint16_t code_len;
+    uint16_t pc;
 };
 
 void tokenizer_init(struct ubasic_tokenizer *data, const char *program);
+uint16_t tokenizer_compile(
+    const char *program, struct ubasic_bytecode *code, uint16_t code_size);
+void tokenizer_init_code(
+    struct ubasic_tokenizer *data,
+    const char *program,
+    const struct ubasic_bytecode *code,
+    uint16_t code_len);
+int32_t tokenizer_label_target(struct ubasic_tokenizer *data);
 void tokenizer_next(struct ubasic_tokenizer *data);
 uint8_t tokenizer_token(struct ubasic_tokenizer *data);
 UBASIC_VARIABLE_TYPE tokenizer_num(struct ubasic_tokenizer *data);
@@ -563,14 +563,54 @@ void ubasic_load_program(struct ubasic_data *data, const char *program)
     data->status.byte = 0x00;
     if (program) {
         data->program = program;
+        data->code = NULL;
+        data->code_len = 0;
     }
     if (data->program) {
         data->program_ptr = data->program;
-        tokenizer_init(&data->tree, data->program_ptr);
+        if (data->code) {
+            tokenizer_init_code(
+                &data->tree, data->program_ptr, data->code, data->code_len);
+        } else {
+            tokenizer_init(&data->tree, data->program_ptr);
+        }
         data->status.bit.isRunning = 1;
     }
 }
 
+/**
+ * @brief Compile and load a program. The compiled program is run instead
+ *  of the program text, and is kept when the program is loaded again
+ *  with ubasic_load_program(data, NULL).
+ * @param data - ubasic data structure
+ * @param program - program text, which must be kept while the program runs
+ * @param code - buffer for the compiled program
+ * @param code_size - number of tokens that fit in the buffer
+ * @return number of tokens in the compiled program, or 0 if the program
+ *  did not fit and was loaded to run from the program text
+ */
+uint16_t ubasic_compile_program(
+    struct ubasic_data *data,
+    const char *program,
+    struct ubasic_bytecode *code,
+    uint16_t code_size)
+{
+    uint16_t code_len;
+
+    ubasic_load_program(data, program);
+    if (!data->program) {
+        return 0;
+    }
+    code_len = tokenizer_compile(data->program, code, code_size);
+    if (code_len > 0) {
+        data->code = code;
+        data->code_len = code_len;
+        tokenizer_init_code(&data->tree, data->program, code, code_len);
+    }
+
+    return code_len;
+}
+
 /*---------------------------------------------------------------------------*/
 static void
 token_error_print(struct ubasic_data *data, UBASIC_VARIABLE_TYPE token)
@@ -1543,11 +1583,21 @@ static UBASIC_VARIABLE_TYPE relation(struct ubasic_data *data)
 }
 
 /* TODO: error handling? */
-static uint8_t jump_label(struct ubasic_data *data, char *label)
+static uint8_t
+jump_label(struct ubasic_data *data, char *label, int32_t target)
 {
     char currLabel[UBASIC_LABEL_LEN_MAX] = { '\0' };
     struct ubasic_tokenizer *tree = &data->tree;
 
+    if (target >= 0) {
+        /* compiled program: the label definition is already known */
+        tokenizer_jump_offset(tree, (uint16_t)target);
+        if (tokenizer_token(tree) == UBASIC_TOKENIZER_LABEL) {
+            accept(data, UBASIC_TOKENIZER_LABEL);
+            return 1;
+        }
+        return 0;
+    }
     tokenizer_init(tree, data->program_ptr);
 
     while (tokenizer_token(tree) != UBASIC_TOKENIZER_ENDOFINPUT) {
@@ -1576,9 +1626,11 @@ static void gosub_statement(struct ubasic_data *data)
 {
     char tmplabel[UBASIC_LABEL_LEN_MAX] = { 0 };
     struct ubasic_tokenizer *tree = &data->tree;
+    int32_t target;
 
     accept(data, UBASIC_TOKENIZER_GOSUB);
     if (tokenizer_token(tree) == UBASIC_TOKENIZER_LABEL) {
+        target = tokenizer_label_target(tree);
         /* copy label */
         tokenizer_label(tree, tmplabel, sizeof(tmplabel));
         tokenizer_next(tree);
@@ -1590,7 +1642,7 @@ static void gosub_statement(struct ubasic_data *data)
             data->gosub_stack[data->gosub_stack_ptr] =
                 tokenizer_save_offset(tree);
             data->gosub_stack_ptr++;
-            jump_label(data, tmplabel);
+            jump_label(data, tmplabel, target);
             return;
         }
     }
@@ -1620,13 +1672,15 @@ static void goto_statement(struct ubasic_data *data)
 {
     char tmplabel[UBASIC_LABEL_LEN_MAX] = { 0 };
     struct ubasic_tokenizer *tree = &data->tree;
+    int32_t target;
 
     accept(data, UBASIC_TOKENIZER_GOTO);
 
     if (tokenizer_token(tree) == UBASIC_TOKENIZER_LABEL) {
+        target = tokenizer_label_target(tree);
         tokenizer_label(tree, tmplabel, sizeof(tmplabel));
         tokenizer_next(tree);
-        jump_label(data, tmplabel);
+        jump_label(data, tmplabel, target);
         return;
     }
 
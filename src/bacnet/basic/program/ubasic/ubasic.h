@@ -118,6 +118,9 @@ struct ubasic_data {
 #endif
     /* entire program */
     const char *program;
+    /* compiled program, or NULL to run from the program text */
+    const struct ubasic_bytecode *code;
+    uint16_t code_len;
     /* points to current statement */
     const char *program_ptr;
     /* copy of the current statement until end-of-line */
@@ -219,6 +222,12 @@ struct ubasic_data {
 BACNET_STACK_EXPORT
 void ubasic_load_program(struct ubasic_data *data, const char *program);
 BACNET_STACK_EXPORT
+uint16_t ubasic_compile_program(
+    struct ubasic_data *data,
+    const char *program,
+    struct ubasic_bytecode *code,
+    uint16_t code_size);
+BACNET_STACK_EXPORT
 void ubasic_clear_variables(struct ubasic_data *data);
 BACNET_STACK_EXPORT
 int32_t ubasic_run_program(struct ubasic_data *data);
@@ -37,46 +37,33 @@ static uint8_t Temp_Buf[MAX_APDU] = { 0 };
 
 /**
  * @brief Fetches the lists of properties (array of BACNET_PROPERTY_ID's) for
- * this object type and the special properties ALL or REQUIRED or OPTIONAL.
+ * this object type and the special properties ALL or REQUIRED or OPTIONAL,
+ * in the order they are to be encoded.
  * @param pPropertyList reference for the list of ALL, REQUIRED, and OPTIONAL
  * properties.
  * @param special_property The special property ALL, REQUIRED, or OPTIONAL
  * to fetch.
- * @param index The index of the property to fetch.
- * @return The property ID or -1 if not found.
+ * @param lists [out] The lists of properties for the special property.
+ * @return The number of lists.
  */
-static BACNET_PROPERTY_ID RPM_Object_Property(
+static unsigned RPM_Object_Property_Lists(
     struct special_property_list_t *pPropertyList,
     BACNET_PROPERTY_ID special_property,
-    unsigned index)
+    const struct property_list_t *lists[3])
 {
-    int property = -1; /* return value */
-    unsigned required, optional, proprietary;
+    unsigned count = 0;
 
-    required = pPropertyList->Required.count;
-    optional = pPropertyList->Optional.count;
-    proprietary = pPropertyList->Proprietary.count;
     if (special_property == PROP_ALL) {
-        if (index < required) {
-            property = pPropertyList->Required.pList[index];
-        } else if (index < (required + optional)) {
-            index -= required;
-            property = pPropertyList->Optional.pList[index];
-        } else if (index < (required + optional + proprietary)) {
-            index -= (required + optional);
-            property = pPropertyList->Proprietary.pList[index];
-        }
+        lists[count++] = &pPropertyList->Required;
+        lists[count++] = &pPropertyList->Optional;
+        lists[count++] = &pPropertyList->Proprietary;
     } else if (special_property == PROP_REQUIRED) {
-        if (index < required) {
-            property = pPropertyList->Required.pList[index];
-        }
+        lists[count++] = &pPropertyList->Required;
     } else if (special_property == PROP_OPTIONAL) {
-        if (index < optional) {
-            property = pPropertyList->Optional.pList[index];
-        }
+        lists[count++] = &pPropertyList->Optional;
     }
 
-    return (BACNET_PROPERTY_ID)property;
+    return count;
 }
 
 /**
@@ -110,6 +97,11 @@ static unsigned RPM_Object_Property_Count(
 /**
  * @brief Encode the RPM property returning the length of the encoding,
  * or 0 if there is no room to fit the encoding.
+ *
+ * The property value is encoded directly into the response when the
+ * object supports the size query mode of its read_property function,
+ * otherwise it is read into a temporary buffer and copied.
+ *
  * @param apdu [out] The buffer to encode the property into.
  * @param offset [in] The offset into the buffer to start encoding.
  * @param max_apdu [in] The maximum length of the buffer.
@@ -121,25 +113,28 @@ static int RPM_Encode_Property(
     uint8_t *apdu, uint16_t offset, uint16_t max_apdu, BACNET_RPM_DATA *rpmdata)
 {
     int len = 0;
-    size_t copy_len = 0;
     int apdu_len = 0;
+    unsigned value_offset = 0;
+    const uint8_t *value = &Temp_Buf[0];
     BACNET_READ_PROPERTY_DATA rpdata;
 
     len = rpm_ack_encode_apdu_object_property(
-        &Temp_Buf[0], rpmdata->object_property, rpmdata->array_index);
-    copy_len = memcopy(&apdu[0], &Temp_Buf[0], offset, len, max_apdu);
-    if (copy_len == 0) {
+        NULL, rpmdata->object_property, rpmdata->array_index);
+    if (!memcopylen(offset, max_apdu, len)) {
         rpmdata->error_code = ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
         return BACNET_STATUS_ABORT;
     }
-    apdu_len += len;
+    apdu_len += rpm_ack_encode_apdu_object_property(
+        &apdu[offset], rpmdata->object_property, rpmdata->array_index);
+    /* the value follows the one octet opening tag */
+    value_offset = offset + apdu_len + 1;
     rpdata.error_class = ERROR_CLASS_OBJECT;
     rpdata.error_code = ERROR_CODE_UNKNOWN_OBJECT;
     rpdata.object_type = rpmdata->object_type;
     rpdata.object_instance = rpmdata->object_instance;
     rpdata.object_property = rpmdata->object_property;
     rpdata.array_index = rpmdata->array_index;
-    rpdata.application_data = &Temp_Buf[0];
+    rpdata.application_data = NULL;
     rpdata.application_data_len = sizeof(Temp_Buf);
 
     if ((rpmdata->object_property == PROP_ALL) ||
@@ -150,7 +145,19 @@ static int RPM_Encode_Property(
     } else if (!read_property_bacnet_array_valid(&rpdata)) {
         len = BACNET_STATUS_ERROR;
     } else {
+        /* size query */
         len = Device_Read_Property(&rpdata);
+        if ((len > 0) && ((value_offset + len + 1) < max_apdu)) {
+            /* encode the value in place */
+            value = &apdu[value_offset];
+            rpdata.application_data = &apdu[value_offset];
+            rpdata.application_data_len = max_apdu - value_offset;
+            len = Device_Read_Property(&rpdata);
+        } else if (len == 0) {
+            /* size query not supported, or an empty value */
+            rpdata.application_data = &Temp_Buf[0];
+            len = Device_Read_Property(&rpdata);
+        }
     }
 
     if (len < 0) {
@@ -159,20 +166,19 @@ static int RPM_Encode_Property(
             /* pass along aborts and rejects for now */
             return len; /* Ie, Abort */
         }
-        /* error was returned - encode that for the response */
+        /* error was returned - roll back any value and encode the error */
         len = rpm_ack_encode_apdu_object_property_error(
-            &Temp_Buf[0], rpdata.error_class, rpdata.error_code);
-        copy_len =
-            memcopy(&apdu[0], &Temp_Buf[0], offset + apdu_len, len, max_apdu);
-
-        if (copy_len == 0) {
+            NULL, rpdata.error_class, rpdata.error_code);
+        if (!memcopylen(offset + apdu_len, max_apdu, len)) {
             rpmdata->error_code = ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
             return BACNET_STATUS_ABORT;
         }
-    } else if ((offset + apdu_len + 1 + len + 1) < max_apdu) {
+        len = rpm_ack_encode_apdu_object_property_error(
+            &apdu[offset + apdu_len], rpdata.error_class, rpdata.error_code);
+    } else if ((value_offset + len + 1) < max_apdu) {
         /* enough room to fit the property value and tags */
         len = rpm_ack_encode_apdu_object_property_value(
-            &apdu[offset + apdu_len], &Temp_Buf[0], len);
+            &apdu[offset + apdu_len], value, len);
     } else {
         /* not enough room - abort! */
         rpmdata->error_code = ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
@@ -210,7 +216,6 @@ void handler_read_property_multiple(
 {
     bool berror = false;
     int len = 0;
-    uint16_t copy_len = 0;
     uint16_t decode_len = 0;
     int pdu_len = 0;
     BACNET_NPDU_DATA npdu_data;
@@ -280,11 +285,8 @@ void handler_read_property_multiple(
                 }
 #endif
                 /* Stick this object id into the reply - if it will fit */
-                len = rpm_ack_encode_apdu_object_begin(&Temp_Buf[0], &rpmdata);
-                copy_len = memcopy(
-                    &Handler_Transmit_Buffer[npdu_len], &Temp_Buf[0], apdu_len,
-                    len, MAX_APDU);
-                if (copy_len == 0) {
+                len = rpm_ack_encode_apdu_object_begin(NULL, &rpmdata);
+                if (!memcopylen(apdu_len, MAX_APDU, len)) {
                     debug_print("RPM: Response too big!\n");
                     rpmdata.error_code =
                         ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
@@ -292,7 +294,8 @@ void handler_read_property_multiple(
                     berror = true;
                     break;
                 }
-                apdu_len += copy_len;
+                apdu_len += rpm_ack_encode_apdu_object_begin(
+                    &Handler_Transmit_Buffer[npdu_len + apdu_len], &rpmdata);
                 /* do each property of this object of the RPM request */
                 for (;;) {
                     /* Fetch a property */
@@ -314,7 +317,10 @@ void handler_read_property_multiple(
                         (rpmdata.object_property == PROP_REQUIRED) ||
                         (rpmdata.object_property == PROP_OPTIONAL)) {
                         struct special_property_list_t property_list;
+                        const struct property_list_t *lists[3];
                         unsigned property_count = 0;
+                        unsigned list_count = 0;
+                        unsigned list = 0;
                         unsigned index = 0;
                         BACNET_PROPERTY_ID special_object_property;
 
@@ -337,14 +343,9 @@ void handler_read_property_multiple(
                             /* No array index options for this special property.
                                Encode error for this object property response */
                             len = rpm_ack_encode_apdu_object_property(
-                                &Temp_Buf[0], rpmdata.object_property,
+                                NULL, rpmdata.object_property,
                                 rpmdata.array_index);
-
-                            copy_len = memcopy(
-                                &Handler_Transmit_Buffer[npdu_len],
-                                &Temp_Buf[0], apdu_len, len, MAX_APDU);
-
-                            if (copy_len == 0) {
+                            if (!memcopylen(apdu_len, MAX_APDU, len)) {
                                 debug_print(
                                     "RPM: Too full to encode property!\n");
                                 rpmdata.error_code =
@@ -356,16 +357,13 @@ void handler_read_property_multiple(
                                 break;
                             }
 
-                            apdu_len += len;
+                            apdu_len += rpm_ack_encode_apdu_object_property(
+                                &Handler_Transmit_Buffer[npdu_len + apdu_len],
+                                rpmdata.object_property, rpmdata.array_index);
                             len = rpm_ack_encode_apdu_object_property_error(
-                                &Temp_Buf[0], ERROR_CLASS_PROPERTY,
+                                NULL, ERROR_CLASS_PROPERTY,
                                 ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY);
-
-                            copy_len = memcopy(
-                                &Handler_Transmit_Buffer[npdu_len],
-                                &Temp_Buf[0], apdu_len, len, MAX_APDU);
-
-                            if (copy_len == 0) {
+                            if (!memcopylen(apdu_len, MAX_APDU, len)) {
                                 debug_print("RPM: Too full to encode error!\n");
                                 rpmdata.error_code =
                                     ERROR_CODE_ABORT_SEGMENTATION_NOT_SUPPORTED;
@@ -375,6 +373,10 @@ void handler_read_property_multiple(
                                 berror = true;
                                 break;
                             }
+                            len = rpm_ack_encode_apdu_object_property_error(
+                                &Handler_Transmit_Buffer[npdu_len + apdu_len],
+                                ERROR_CLASS_PROPERTY,
+                                ERROR_CODE_PROPERTY_IS_NOT_AN_ARRAY);
                             apdu_len += len;
                         } else {
                             special_object_property = rpmdata.object_property;
@@ -411,25 +413,30 @@ void handler_read_property_multiple(
                                     }
                                 }
                             } else {
-                                for (index = 0; index < property_count;
-                                     index++) {
-                                    rpmdata.object_property =
-                                        RPM_Object_Property(
-                                            &property_list,
-                                            special_object_property, index);
-                                    len = RPM_Encode_Property(
-                                        &Handler_Transmit_Buffer[npdu_len],
-                                        (uint16_t)apdu_len, MAX_APDU, &rpmdata);
-                                    if (len > 0) {
-                                        apdu_len += len;
-                                    } else {
-                                        debug_print(
-                                            "RPM: Too full for property!\n");
-                                        error = len;
-                                        /* The berror flag ensures that
-                                           both loops will be broken! */
-                                        berror = true;
-                                        break;
+                                list_count = RPM_Object_Property_Lists(
+                                    &property_list, special_object_property,
+                                    lists);
+                                for (list = 0; (list < list_count) && !berror;
+                                     list++) {
+                                    for (index = 0; index < lists[list]->count;
+                                         index++) {
+                                        rpmdata.object_property =
+                                            lists[list]->pList[index];
+                                        len = RPM_Encode_Property(
+                                            &Handler_Transmit_Buffer[npdu_len],
+                                            (uint16_t)apdu_len, MAX_APDU,
+                                            &rpmdata);
+                                        if (len > 0) {
+                                            apdu_len += len;
+                                        } else {
+                                            debug_print("RPM: Too full for "
+                                                        "property!\n");
+                                            error = len;
+                                            /* The berror flag ensures that
+                                               all loops will be broken! */
+                                            berror = true;
+                                            break;
+                                        }
                                     }
                                 }
                             }
@@ -458,11 +465,8 @@ void handler_read_property_multiple(
                         /* Reached end of property list so cap the result list
                          */
                         decode_len += tag_len;
-                        len = rpm_ack_encode_apdu_object_end(&Temp_Buf[0]);
-                        copy_len = memcopy(
-                            &Handler_Transmit_Buffer[npdu_len], &Temp_Buf[0],
-                            apdu_len, len, MAX_APDU);
-                        if (copy_len == 0) {
+                        len = rpm_ack_encode_apdu_object_end(NULL);
+                        if (!memcopylen(apdu_len, MAX_APDU, len)) {
                             debug_print(
                                 "RPM: Too full to encode object end!\n");
                             rpmdata.error_code =
@@ -473,7 +477,8 @@ void handler_read_property_multiple(
                             berror = true;
                             break;
                         } else {
-                            apdu_len += copy_len;
+                            apdu_len += rpm_ack_encode_apdu_object_end(
+                                &Handler_Transmit_Buffer[npdu_len + apdu_len]);
                         }
                         /* finished with this property list */
                         break;
@@ -27,6 +27,8 @@
 #define PRINTF debug_printf_stdout
 
 /** Decode the received RPM data and make a linked list of the results.
+ * The property values are decoded as the reader walks them, without
+ * first measuring each enclosed value.
  * @ingroup DSRPM
  *
  * @param apdu [in] The received apdu data.
@@ -40,30 +42,29 @@ int rpm_ack_decode_service_request(
     int apdu_len,
     BACNET_READ_ACCESS_DATA *read_access_data)
 {
-    int decoded_len = 0; /* return value */
-    uint32_t error_value = 0; /* decoded error value */
+    BACNET_READER reader = { 0 };
     int len = 0; /* number of bytes returned from decoding */
-    uint8_t tag_number = 0; /* decoded tag number */
-    int data_len = 0; /* data blob length */
-    int data_remaining = 0; /* bytes left in the current data blob */
-    int tag_len = 0; /* length of the tag portion of the data */
     BACNET_READ_ACCESS_DATA *rpm_object;
     BACNET_READ_ACCESS_DATA *old_rpm_object;
     BACNET_PROPERTY_REFERENCE *rpm_property;
     BACNET_PROPERTY_REFERENCE *old_rpm_property;
     BACNET_APPLICATION_DATA_VALUE *value;
     BACNET_APPLICATION_DATA_VALUE *old_value;
+    bool value_closed = false;
 
     if (!read_access_data) {
         return 0;
     }
+    if (apdu_len < 0) {
+        return BACNET_STATUS_ERROR;
+    }
+    bacnet_reader_init(&reader, apdu, (uint32_t)apdu_len);
     rpm_object = read_access_data;
     old_rpm_object = rpm_object;
-    while (rpm_object && apdu_len) {
-        len = rpm_ack_decode_object_id(
-            apdu, apdu_len, &rpm_object->object_type,
-            &rpm_object->object_instance);
-        if (len <= 0) {
+    while (rpm_object && bacnet_reader_remaining(&reader)) {
+        if (!rpm_ack_read_object_id(
+                &reader, &rpm_object->object_type,
+                &rpm_object->object_instance)) {
             old_rpm_object->next = NULL;
             if (rpm_object != read_access_data) {
                 /* don't free original */
@@ -72,17 +73,13 @@ int rpm_ack_decode_service_request(
             }
             break;
         }
-        decoded_len += len;
-        apdu_len -= len;
-        apdu += len;
         rpm_property = calloc(1, sizeof(BACNET_PROPERTY_REFERENCE));
         rpm_object->listOfProperties = rpm_property;
         old_rpm_property = rpm_property;
-        while (rpm_property && apdu_len) {
-            len = rpm_ack_decode_object_property(
-                apdu, apdu_len, &rpm_property->propertyIdentifier,
-                &rpm_property->propertyArrayIndex);
-            if (len <= 0) {
+        while (rpm_property && bacnet_reader_remaining(&reader)) {
+            if (!rpm_ack_read_object_property(
+                    &reader, &rpm_property->propertyIdentifier,
+                    &rpm_property->propertyArrayIndex)) {
                 old_rpm_property->next = NULL;
                 if (rpm_object->listOfProperties == rpm_property) {
                     /* was this the only property in the list? */
@@ -92,74 +89,43 @@ int rpm_ack_decode_service_request(
                 rpm_property = NULL;
                 break;
             }
-            decoded_len += len;
-            apdu_len -= len;
-            apdu += len;
-            if (apdu_len &&
-                bacnet_is_opening_tag_number(apdu, apdu_len, 4, &tag_len)) {
-                data_len = bacnet_enclosed_data_length(apdu, apdu_len);
-                if (data_len < 0) {
-                    debug_log_fprintf(
-                        DEBUG_LOG_ERROR, stderr,
-                        "RPM Ack: invalid enclosed property value length\n");
-                    return BACNET_STATUS_ERROR;
-                }
+            if (bacnet_reader_opening(&reader, 4)) {
                 /* propertyValue */
-                decoded_len += tag_len;
-                apdu_len -= tag_len;
-                apdu += tag_len;
-                data_remaining = data_len;
                 value = calloc(1, sizeof(BACNET_APPLICATION_DATA_VALUE));
                 rpm_property->value = value;
-                if (apdu_len &&
-                    bacnet_is_closing_tag_number(apdu, apdu_len, 4, &tag_len)) {
+                if (bacnet_reader_closing(&reader, 4)) {
                     /* Special case for an empty array or list */
                     if (value) {
                         bacapp_value_list_init(value, 1);
                         value->tag = BACNET_APPLICATION_TAG_EMPTYLIST;
                     }
-                    decoded_len += tag_len;
-                    apdu_len -= tag_len;
-                    apdu += tag_len;
                 } else {
                     /* one or more (array or list) elements to decode */
-                    while (value && (apdu_len > 0)) {
+                    value_closed = false;
+                    while (value && bacnet_reader_remaining(&reader)) {
                         len = bacapp_decode_known_array_property(
-                            apdu, (unsigned)apdu_len, value,
+                            bacnet_reader_data(&reader),
+                            bacnet_reader_remaining(&reader), value,
                             rpm_object->object_type,
                             rpm_property->propertyIdentifier,
                             rpm_property->propertyArrayIndex);
                         /* If len == 0 then it's an empty structure, which is
                          * OK. */
                         if (len < 0) {
-                            /* problem decoding */
-                            len = data_remaining;
+                            /* problem decoding: skip the rest of the value */
                             bacapp_value_list_init(value, 1);
+                            while (!bacnet_reader_is_closing(&reader, 4)) {
+                                if (bacnet_reader_skip(&reader) < 0) {
+                                    break;
+                                }
+                            }
+                            len = 0;
+                        } else if (!bacnet_reader_advance(
+                                       &reader, (uint32_t)len)) {
+                            break;
                         }
-                        if (len > data_remaining) {
-                            debug_log_fprintf(
-                                DEBUG_LOG_ERROR, stderr,
-                                "RPM Ack: decoded length exceeds property "
-                                "value length\n");
-                            return BACNET_STATUS_ERROR;
-                        }
-                        decoded_len += len;
-                        apdu_len -= len;
-                        apdu += len;
-                        data_remaining -= len;
-                        if ((apdu_len < 0) || (data_remaining < 0)) {
-                            debug_log_fprintf(
-                                DEBUG_LOG_ERROR, stderr,
-                                "RPM Ack: invalid remaining length while "
-                                "decoding property value\n");
-                            return BACNET_STATUS_ERROR;
-                        }
-                        if (apdu_len > 0 &&
-                            bacnet_is_closing_tag_number(
-                                apdu, (unsigned)apdu_len, 4, &tag_len)) {
-                            decoded_len += tag_len;
-                            apdu_len -= tag_len;
-                            apdu += tag_len;
+                        if (bacnet_reader_closing(&reader, 4)) {
+                            value_closed = true;
                             break;
                         } else if (len > 0) {
                             old_value = value;
@@ -178,74 +144,37 @@ int rpm_ack_decode_service_request(
                             break;
                         }
                     }
+                    if (!value_closed) {
+                        debug_log_fprintf(
+                            DEBUG_LOG_ERROR, stderr,
+                            "RPM Ack: invalid enclosed property value\n");
+                        return BACNET_STATUS_ERROR;
+                    }
                 }
-            } else if (
-                apdu_len &&
-                bacnet_is_opening_tag_number(apdu, apdu_len, 5, &tag_len)) {
+            } else if (bacnet_reader_is_opening(&reader, 5)) {
                 /* propertyAccessError */
-                decoded_len += tag_len;
-                apdu_len -= tag_len;
-                apdu += tag_len;
-                /* decode the class and code sequence */
-                len = bacnet_enumerated_application_decode(
-                    apdu, apdu_len, &error_value);
-                if (len <= 0) {
+                if (!rpm_ack_read_access_error(
+                        &reader, &rpm_property->error.error_class,
+                        &rpm_property->error.error_code)) {
                     debug_log_fprintf(
                         DEBUG_LOG_ERROR, stderr,
-                        "RPM Ack: unable to decode error class!\n");
+                        "RPM Ack: unable to decode property access error!\n");
                     return BACNET_STATUS_ERROR;
                 }
-                decoded_len += len;
-                apdu_len -= len;
-                apdu += len;
-                rpm_property->error.error_class =
-                    (BACNET_ERROR_CLASS)error_value;
-                len = bacnet_enumerated_application_decode(
-                    apdu, apdu_len, &error_value);
-                if (len <= 0) {
-                    debug_log_fprintf(
-                        DEBUG_LOG_ERROR, stderr,
-                        "RPM Ack: unable to decode error code!\n");
-                    return BACNET_STATUS_ERROR;
-                }
-                decoded_len += len;
-                apdu_len -= len;
-                apdu += len;
-                rpm_property->error.error_code = (BACNET_ERROR_CODE)error_value;
-                if (apdu_len) {
-                    if (bacnet_is_closing_tag_number(
-                            apdu, apdu_len, 5, &tag_len)) {
-                        decoded_len += tag_len;
-                        apdu_len -= tag_len;
-                        apdu += tag_len;
-                    } else {
-                        debug_log_fprintf(
-                            DEBUG_LOG_ERROR, stderr,
-                            "RPM Ack: expected closing tag for error code, got "
-                            "%d\n",
-                            tag_number);
-                        return BACNET_STATUS_ERROR;
-                    }
-                }
             }
             old_rpm_property = rpm_property;
             rpm_property = calloc(1, sizeof(BACNET_PROPERTY_REFERENCE));
             old_rpm_property->next = rpm_property;
         }
-        len = rpm_decode_object_end(apdu, apdu_len);
-        if (len > 0) {
-            decoded_len += len;
-            apdu_len -= len;
-            apdu += len;
-        }
-        if (apdu_len) {
+        (void)bacnet_reader_closing(&reader, 1);
+        if (bacnet_reader_remaining(&reader)) {
             old_rpm_object = rpm_object;
             rpm_object = calloc(1, sizeof(BACNET_READ_ACCESS_DATA));
             old_rpm_object->next = rpm_object;
         }
     }
 
-    return decoded_len;
+    return (int)bacnet_reader_offset(&reader);
 }
 
 /* for debugging... */
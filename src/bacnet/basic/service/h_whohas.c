@@ -113,6 +113,8 @@ void handler_who_has_for_routing(
     BACNET_WHO_HAS_DATA data;
     int32_t dev_instance;
     int cursor = 0; /* Starting hint */
+    uint16_t device_index = 0;
+    uint16_t previous_index;
     int32_t my_list[2] = { 0, -1 }; /* Not really used, so dummy values */
     BACNET_ADDRESS bcast_net;
 
@@ -123,7 +125,10 @@ void handler_who_has_for_routing(
         memset(&bcast_net, 0, sizeof(BACNET_ADDRESS));
         bcast_net.net =
             BACNET_BROADCAST_NETWORK; /* That's all we have to set */
-        while (Routed_Device_GetNext(&bcast_net, my_list, &cursor)) {
+        previous_index = Routed_Device_Object_Index();
+        while (Routed_Device_Find_Next(
+            &bcast_net, my_list, &cursor, &device_index)) {
+            Set_Routed_Device_Object_Index(device_index);
             dev_instance = Device_Object_Instance_Number();
             if ((data.low_limit == -1) || (data.high_limit == -1) ||
                 ((dev_instance >= data.low_limit) &&
@@ -131,6 +136,7 @@ void handler_who_has_for_routing(
                 match_name_or_object(&data);
             }
         }
+        Set_Routed_Device_Object_Index(previous_index);
     }
 }
 #endif /* BAC_ROUTING */
@@ -160,6 +160,8 @@ static void check_who_is_for_routing(
     int32_t high_limit = 0;
     int32_t dev_instance;
     int cursor = 0; /* Starting hint */
+    uint16_t device_index = 0;
+    uint16_t previous_index;
     int32_t my_list[2] = { 0, -1 }; /* Not really used, so dummy values */
     BACNET_ADDRESS bcast_net;
 
@@ -173,7 +175,10 @@ static void check_who_is_for_routing(
     memset(&bcast_net, 0, sizeof(BACNET_ADDRESS));
     bcast_net.net = BACNET_BROADCAST_NETWORK; /* That's all we have to set */
 
-    while (Routed_Device_GetNext(&bcast_net, my_list, &cursor)) {
+    previous_index = Routed_Device_Object_Index();
+    while (Routed_Device_Find_Next(
+        &bcast_net, my_list, &cursor, &device_index)) {
+        Set_Routed_Device_Object_Index(device_index);
         dev_instance = Device_Object_Instance_Number();
         /* If len == 0, no limits and always respond */
         if ((len == 0) ||
@@ -185,6 +190,7 @@ static void check_who_is_for_routing(
             }
         }
     }
+    Set_Routed_Device_Object_Index(previous_index);
 }
 
 /** Handler for Who-Is requests in the virtual routing setup,
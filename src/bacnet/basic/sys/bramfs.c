@@ -35,15 +35,8 @@ struct file_data {
  */
 static uint32_t pathname_crc32k(const char *pathname)
 {
-    uint32_t crc32K = CRC32K_INITIAL_VALUE;
-    size_t len, i;
-
-    len = strlen(pathname);
-    for (i = 0; i < len; i++) {
-        crc32K = cobs_crc32k(pathname[i], crc32K);
-    }
-
-    return crc32K;
+    return cobs_crc32k_buffer(
+        (const uint8_t *)pathname, strlen(pathname), CRC32K_INITIAL_VALUE);
 }
 
 /**
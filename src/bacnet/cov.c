@@ -361,6 +361,8 @@ int ucov_notify_encode_apdu(
  *  }
  *
  * @note: COV and Unconfirmed COV are the same.
+ * @note: The list-of-values is skipped in a single pass when data is NULL
+ *  or has no listOfValues to decode into.
  * @param apdu  Pointer to the buffer.
  * @param apdu_size  Number of valid bytes in the buffer.
  * @param data  Pointer to the data to store the decoded values, or NULL
@@ -370,103 +372,81 @@ int ucov_notify_encode_apdu(
 int cov_notify_decode_service_request(
     const uint8_t *apdu, unsigned apdu_size, BACNET_COV_DATA *data)
 {
-    int len = 0; /* return value */
-    int value_len = 0, tag_len = 0;
+    BACNET_READER reader = { 0 };
+    int value_len = 0;
     BACNET_UNSIGNED_INTEGER decoded_value = 0;
     BACNET_OBJECT_TYPE decoded_type = OBJECT_NONE;
     uint32_t decoded_instance = 0;
     BACNET_PROPERTY_VALUE *value = NULL;
 
+    bacnet_reader_init(&reader, apdu, apdu_size);
     /* subscriber-process-identifier [0] Unsigned32 */
-    value_len = bacnet_unsigned_context_decode(
-        &apdu[len], apdu_size - len, 0, &decoded_value);
-    if (value_len > 0) {
-        if (data) {
-            data->subscriberProcessIdentifier = decoded_value;
-        }
-        len += value_len;
-    } else {
+    if (!bacnet_reader_context_unsigned(&reader, 0, &decoded_value)) {
         return BACNET_STATUS_ERROR;
     }
+    if (data) {
+        data->subscriberProcessIdentifier = decoded_value;
+    }
     /* initiating-device-identifier [1] BACnetObjectIdentifier */
-    value_len = bacnet_object_id_context_decode(
-        &apdu[len], apdu_size - len, 1, &decoded_type, &decoded_instance);
-    if (value_len > 0) {
-        if (decoded_type != OBJECT_DEVICE) {
-            return BACNET_STATUS_ERROR;
-        }
-        if (data) {
-            data->initiatingDeviceIdentifier = decoded_instance;
-        }
-        len += value_len;
-    } else {
+    if (!bacnet_reader_context_object_id(
+            &reader, 1, &decoded_type, &decoded_instance)) {
+        return BACNET_STATUS_ERROR;
+    }
+    if (decoded_type != OBJECT_DEVICE) {
         return BACNET_STATUS_ERROR;
     }
+    if (data) {
+        data->initiatingDeviceIdentifier = decoded_instance;
+    }
     /* monitored-object-identifier [2] BACnetObjectIdentifier */
-    value_len = bacnet_object_id_context_decode(
-        &apdu[len], apdu_size - len, 2, &decoded_type, &decoded_instance);
-    if (value_len > 0) {
-        if (data) {
-            data->monitoredObjectIdentifier.type = decoded_type;
-            data->monitoredObjectIdentifier.instance = decoded_instance;
-        }
-        len += value_len;
-    } else {
+    if (!bacnet_reader_context_object_id(
+            &reader, 2, &decoded_type, &decoded_instance)) {
         return BACNET_STATUS_ERROR;
     }
+    if (data) {
+        data->monitoredObjectIdentifier.type = decoded_type;
+        data->monitoredObjectIdentifier.instance = decoded_instance;
+    }
     /* time-remaining [3] Unsigned */
-    value_len = bacnet_unsigned_context_decode(
-        &apdu[len], apdu_size - len, 3, &decoded_value);
-    if (value_len > 0) {
-        if (data) {
-            data->timeRemaining = decoded_value;
-        }
-        len += value_len;
-    } else {
+    if (!bacnet_reader_context_unsigned(&reader, 3, &decoded_value)) {
         return BACNET_STATUS_ERROR;
     }
+    if (data) {
+        data->timeRemaining = decoded_value;
+        /* the first value includes a pointer to the next value, etc */
+        value = data->listOfValues;
+    }
     /* list-of-values [4] SEQUENCE OF BACnetPropertyValue */
-    if (bacnet_is_opening_tag_number(
-            &apdu[len], apdu_size - len, 4, &tag_len)) {
-        if (data) {
-            len += tag_len;
-            /* the first value includes a pointer to the next value, etc */
-            value = data->listOfValues;
-            while (value != NULL) {
-                value_len = bacapp_object_property_value_decode(
-                    &apdu[len], apdu_size - len, value, decoded_type);
-                if (value_len == BACNET_STATUS_ERROR) {
-                    return BACNET_STATUS_ERROR;
-                } else {
-                    len += value_len;
-                }
-                /* end of list? */
-                if (bacnet_is_closing_tag_number(
-                        &apdu[len], apdu_size - len, 4, &tag_len)) {
-                    len += tag_len;
-                    value->next = NULL;
-                    break;
-                }
-                /* is there another one to decode? */
-                value = value->next;
-                if (value == NULL) {
-                    /* out of room to store next value */
-                    return BACNET_STATUS_ERROR;
-                }
+    if (!value) {
+        /* nowhere to store the values: skip them in a single pass */
+        if (bacnet_reader_is_opening(&reader, 4) &&
+            !bacnet_reader_enclosed(&reader, 4, NULL, NULL)) {
+            return BACNET_STATUS_ERROR;
+        }
+    } else if (bacnet_reader_opening(&reader, 4)) {
+        while (value != NULL) {
+            value_len = bacapp_object_property_value_decode(
+                bacnet_reader_data(&reader), bacnet_reader_remaining(&reader),
+                value, decoded_type);
+            if ((value_len < 0) ||
+                !bacnet_reader_advance(&reader, (uint32_t)value_len)) {
+                return BACNET_STATUS_ERROR;
+            }
+            /* end of list? */
+            if (bacnet_reader_closing(&reader, 4)) {
+                value->next = NULL;
+                break;
+            }
+            /* is there another one to decode? */
+            value = value->next;
+            if (value == NULL) {
+                /* out of room to store next value */
+                return BACNET_STATUS_ERROR;
             }
-        } else {
-            /* this len function needs to start at the opening tag
-               to match opening/closing tags like a stack.
-               However, it returns the len between the tags. */
-            value_len =
-                bacnet_enclosed_data_length(&apdu[len], apdu_size - len);
-            len += value_len;
-            /* add the opening tag length to the totals */
-            len += tag_len;
         }
     }
 
-    return len;
+    return (int)bacnet_reader_offset(&reader);
 }
 
 /*
@@ -90,6 +90,9 @@ void bip6_receive_callback(void);
 BACNET_STACK_EXPORT
 void bip6_debug_enable(void);
 
+BACNET_STACK_EXPORT
+int bip6_get_socket(void);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -61,6 +61,419 @@ uint32_t cobs_crc32k(uint8_t dataValue, uint32_t crc32kValue)
     return crc; /* Return updated crc value */
 }
 
+#if defined(CRC_USE_SLICE_BY_8)
+/* note: table 0 is the octet-at-a-time CRC-32K table, and table k
+   is table k-1 advanced by one more zero octet, so that eight octets
+   are folded into the CRC with one round of lookups */
+static const uint32_t CRC32K_Slice[8][256] = {
+    {
+        0x00000000, 0x9695c4ca, 0xfb4839c9, 0x6dddfd03, 0x20f3c3cf, 0xb6660705,
+        0xdbbbfa06, 0x4d2e3ecc, 0x41e7879e, 0xd7724354, 0xbaafbe57, 0x2c3a7a9d,
+        0x61144451, 0xf781809b, 0x9a5c7d98, 0x0cc9b952, 0x83cf0f3c, 0x155acbf6,
+        0x788736f5, 0xee12f23f, 0xa33cccf3, 0x35a90839, 0x5874f53a, 0xcee131f0,
+        0xc22888a2, 0x54bd4c68, 0x3960b16b, 0xaff575a1, 0xe2db4b6d, 0x744e8fa7,
+        0x199372a4, 0x8f06b66e, 0xd1fdae25, 0x47686aef, 0x2ab597ec, 0xbc205326,
+        0xf10e6dea, 0x679ba920, 0x0a465423, 0x9cd390e9, 0x901a29bb, 0x068fed71,
+        0x6b521072, 0xfdc7d4b8, 0xb0e9ea74, 0x267c2ebe, 0x4ba1d3bd, 0xdd341777,
+        0x5232a119, 0xc4a765d3, 0xa97a98d0, 0x3fef5c1a, 0x72c162d6, 0xe454a61c,
+        0x89895b1f, 0x1f1c9fd5, 0x13d52687, 0x8540e24d, 0xe89d1f4e, 0x7e08db84,
+        0x3326e548, 0xa5b32182, 0xc86edc81, 0x5efb184b, 0x7598ec17, 0xe30d28dd,
+        0x8ed0d5de, 0x18451114, 0x556b2fd8, 0xc3feeb12, 0xae231611, 0x38b6d2db,
+        0x347f6b89, 0xa2eaaf43, 0xcf375240, 0x59a2968a, 0x148ca846, 0x82196c8c,
+        0xefc4918f, 0x79515545, 0xf657e32b, 0x60c227e1, 0x0d1fdae2, 0x9b8a1e28,
+        0xd6a420e4, 0x4031e42e, 0x2dec192d, 0xbb79dde7, 0xb7b064b5, 0x2125a07f,
+        0x4cf85d7c, 0xda6d99b6, 0x9743a77a, 0x01d663b0, 0x6c0b9eb3, 0xfa9e5a79,
+        0xa4654232, 0x32f086f8, 0x5f2d7bfb, 0xc9b8bf31, 0x849681fd, 0x12034537,
+        0x7fdeb834, 0xe94b7cfe, 0xe582c5ac, 0x73170166, 0x1ecafc65, 0x885f38af,
+        0xc5710663, 0x53e4c2a9, 0x3e393faa, 0xa8acfb60, 0x27aa4d0e, 0xb13f89c4,
+        0xdce274c7, 0x4a77b00d, 0x07598ec1, 0x91cc4a0b, 0xfc11b708, 0x6a8473c2,
+        0x664dca90, 0xf0d80e5a, 0x9d05f359, 0x0b903793, 0x46be095f, 0xd02bcd95,
+        0xbdf63096, 0x2b63f45c, 0xeb31d82e, 0x7da41ce4, 0x1079e1e7, 0x86ec252d,
+        0xcbc21be1, 0x5d57df2b, 0x308a2228, 0xa61fe6e2, 0xaad65fb0, 0x3c439b7a,
+        0x519e6679, 0xc70ba2b3, 0x8a259c7f, 0x1cb058b5, 0x716da5b6, 0xe7f8617c,
+        0x68fed712, 0xfe6b13d8, 0x93b6eedb, 0x05232a11, 0x480d14dd, 0xde98d017,
+        0xb3452d14, 0x25d0e9de, 0x2919508c, 0xbf8c9446, 0xd2516945, 0x44c4ad8f,
+        0x09ea9343, 0x9f7f5789, 0xf2a2aa8a, 0x64376e40, 0x3acc760b, 0xac59b2c1,
+        0xc1844fc2, 0x57118b08, 0x1a3fb5c4, 0x8caa710e, 0xe1778c0d, 0x77e248c7,
+        0x7b2bf195, 0xedbe355f, 0x8063c85c, 0x16f60c96, 0x5bd8325a, 0xcd4df690,
+        0xa0900b93, 0x3605cf59, 0xb9037937, 0x2f96bdfd, 0x424b40fe, 0xd4de8434,
+        0x99f0baf8, 0x0f657e32, 0x62b88331, 0xf42d47fb, 0xf8e4fea9, 0x6e713a63,
+        0x03acc760, 0x953903aa, 0xd8173d66, 0x4e82f9ac, 0x235f04af, 0xb5cac065,
+        0x9ea93439, 0x083cf0f3, 0x65e10df0, 0xf374c93a, 0xbe5af7f6, 0x28cf333c,
+        0x4512ce3f, 0xd3870af5, 0xdf4eb3a7, 0x49db776d, 0x24068a6e, 0xb2934ea4,
+        0xffbd7068, 0x6928b4a2, 0x04f549a1, 0x92608d6b, 0x1d663b05, 0x8bf3ffcf,
+        0xe62e02cc, 0x70bbc606, 0x3d95f8ca, 0xab003c00, 0xc6ddc103, 0x504805c9,
+        0x5c81bc9b, 0xca147851, 0xa7c98552, 0x315c4198, 0x7c727f54, 0xeae7bb9e,
+        0x873a469d, 0x11af8257, 0x4f549a1c, 0xd9c15ed6, 0xb41ca3d5, 0x2289671f,
+        0x6fa759d3, 0xf9329d19, 0x94ef601a, 0x027aa4d0, 0x0eb31d82, 0x9826d948,
+        0xf5fb244b, 0x636ee081, 0x2e40de4d, 0xb8d51a87, 0xd508e784, 0x439d234e,
+        0xcc9b9520, 0x5a0e51ea, 0x37d3ace9, 0xa1466823, 0xec6856ef, 0x7afd9225,
+        0x17206f26, 0x81b5abec, 0x8d7c12be, 0x1be9d674, 0x76342b77, 0xe0a1efbd,
+        0xad8fd171, 0x3b1a15bb, 0x56c7e8b8, 0xc0522c72
+    },
+    {
+        0x00000000, 0x24901faa, 0x49203f54, 0x6db020fe, 0x92407ea8, 0xb6d06102,
+        0xdb6041fc, 0xfff05e56, 0xf2e34d0d, 0xd67352a7, 0xbbc37259, 0x9f536df3,
+        0x60a333a5, 0x44332c0f, 0x29830cf1, 0x0d13135b, 0x33a52a47, 0x173535ed,
+        0x7a851513, 0x5e150ab9, 0xa1e554ef, 0x85754b45, 0xe8c56bbb, 0xcc557411,
+        0xc146674a, 0xe5d678e0, 0x8866581e, 0xacf647b4, 0x530619e2, 0x77960648,
+        0x1a2626b6, 0x3eb6391c, 0x674a548e, 0x43da4b24, 0x2e6a6bda, 0x0afa7470,
+        0xf50a2a26, 0xd19a358c, 0xbc2a1572, 0x98ba0ad8, 0x95a91983, 0xb1390629,
+        0xdc8926d7, 0xf819397d, 0x07e9672b, 0x23797881, 0x4ec9587f, 0x6a5947d5,
+        0x54ef7ec9, 0x707f6163, 0x1dcf419d, 0x395f5e37, 0xc6af0061, 0xe23f1fcb,
+        0x8f8f3f35, 0xab1f209f, 0xa60c33c4, 0x829c2c6e, 0xef2c0c90, 0xcbbc133a,
+        0x344c4d6c, 0x10dc52c6, 0x7d6c7238, 0x59fc6d92, 0xce94a91c, 0xea04b6b6,
+        0x87b49648, 0xa32489e2, 0x5cd4d7b4, 0x7844c81e, 0x15f4e8e0, 0x3164f74a,
+        0x3c77e411, 0x18e7fbbb, 0x7557db45, 0x51c7c4ef, 0xae379ab9, 0x8aa78513,
+        0xe717a5ed, 0xc387ba47, 0xfd31835b, 0xd9a19cf1, 0xb411bc0f, 0x9081a3a5,
+        0x6f71fdf3, 0x4be1e259, 0x2651c2a7, 0x02c1dd0d, 0x0fd2ce56, 0x2b42d1fc,
+        0x46f2f102, 0x6262eea8, 0x9d92b0fe, 0xb902af54, 0xd4b28faa, 0xf0229000,
+        0xa9defd92, 0x8d4ee238, 0xe0fec2c6, 0xc46edd6c, 0x3b9e833a, 0x1f0e9c90,
+        0x72bebc6e, 0x562ea3c4, 0x5b3db09f, 0x7fadaf35, 0x121d8fcb, 0x368d9061,
+        0xc97dce37, 0xededd19d, 0x805df163, 0xa4cdeec9, 0x9a7bd7d5, 0xbeebc87f,
+        0xd35be881, 0xf7cbf72b, 0x083ba97d, 0x2cabb6d7, 0x411b9629, 0x658b8983,
+        0x68989ad8, 0x4c088572, 0x21b8a58c, 0x0528ba26, 0xfad8e470, 0xde48fbda,
+        0xb3f8db24, 0x9768c48e, 0x4b4ae265, 0x6fdafdcf, 0x026add31, 0x26fac29b,
+        0xd90a9ccd, 0xfd9a8367, 0x902aa399, 0xb4babc33, 0xb9a9af68, 0x9d39b0c2,
+        0xf089903c, 0xd4198f96, 0x2be9d1c0, 0x0f79ce6a, 0x62c9ee94, 0x4659f13e,
+        0x78efc822, 0x5c7fd788, 0x31cff776, 0x155fe8dc, 0xeaafb68a, 0xce3fa920,
+        0xa38f89de, 0x871f9674, 0x8a0c852f, 0xae9c9a85, 0xc32cba7b, 0xe7bca5d1,
+        0x184cfb87, 0x3cdce42d, 0x516cc4d3, 0x75fcdb79, 0x2c00b6eb, 0x0890a941,
+        0x652089bf, 0x41b09615, 0xbe40c843, 0x9ad0d7e9, 0xf760f717, 0xd3f0e8bd,
+        0xdee3fbe6, 0xfa73e44c, 0x97c3c4b2, 0xb353db18, 0x4ca3854e, 0x68339ae4,
+        0x0583ba1a, 0x2113a5b0, 0x1fa59cac, 0x3b358306, 0x5685a3f8, 0x7215bc52,
+        0x8de5e204, 0xa975fdae, 0xc4c5dd50, 0xe055c2fa, 0xed46d1a1, 0xc9d6ce0b,
+        0xa466eef5, 0x80f6f15f, 0x7f06af09, 0x5b96b0a3, 0x3626905d, 0x12b68ff7,
+        0x85de4b79, 0xa14e54d3, 0xccfe742d, 0xe86e6b87, 0x179e35d1, 0x330e2a7b,
+        0x5ebe0a85, 0x7a2e152f, 0x773d0674, 0x53ad19de, 0x3e1d3920, 0x1a8d268a,
+        0xe57d78dc, 0xc1ed6776, 0xac5d4788, 0x88cd5822, 0xb67b613e, 0x92eb7e94,
+        0xff5b5e6a, 0xdbcb41c0, 0x243b1f96, 0x00ab003c, 0x6d1b20c2, 0x498b3f68,
+        0x44982c33, 0x60083399, 0x0db81367, 0x29280ccd, 0xd6d8529b, 0xf2484d31,
+        0x9ff86dcf, 0xbb687265, 0xe2941ff7, 0xc604005d, 0xabb420a3, 0x8f243f09,
+        0x70d4615f, 0x54447ef5, 0x39f45e0b, 0x1d6441a1, 0x107752fa, 0x34e74d50,
+        0x59576dae, 0x7dc77204, 0x82372c52, 0xa6a733f8, 0xcb171306, 0xef870cac,
+        0xd13135b0, 0xf5a12a1a, 0x98110ae4, 0xbc81154e, 0x43714b18, 0x67e154b2,
+        0x0a51744c, 0x2ec16be6, 0x23d278bd, 0x07426717, 0x6af247e9, 0x4e625843,
+        0xb1920615, 0x950219bf, 0xf8b23941, 0xdc2226eb
+    },
+    {
+        0x00000000, 0x80475843, 0xd6ed00db, 0x56aa5898, 0x7bb9b1eb, 0xfbfee9a8,
+        0xad54b130, 0x2d13e973, 0xf77363d6, 0x77343b95, 0x219e630d, 0xa1d93b4e,
+        0x8ccad23d, 0x0c8d8a7e, 0x5a27d2e6, 0xda608aa5, 0x388577f1, 0xb8c22fb2,
+        0xee68772a, 0x6e2f2f69, 0x433cc61a, 0xc37b9e59, 0x95d1c6c1, 0x15969e82,
+        0xcff61427, 0x4fb14c64, 0x191b14fc, 0x995c4cbf, 0xb44fa5cc, 0x3408fd8f,
+        0x62a2a517, 0xe2e5fd54, 0x710aefe2, 0xf14db7a1, 0xa7e7ef39, 0x27a0b77a,
+        0x0ab35e09, 0x8af4064a, 0xdc5e5ed2, 0x5c190691, 0x86798c34, 0x063ed477,
+        0x50948cef, 0xd0d3d4ac, 0xfdc03ddf, 0x7d87659c, 0x2b2d3d04, 0xab6a6547,
+        0x498f9813, 0xc9c8c050, 0x9f6298c8, 0x1f25c08b, 0x323629f8, 0xb27171bb,
+        0xe4db2923, 0x649c7160, 0xbefcfbc5, 0x3ebba386, 0x6811fb1e, 0xe856a35d,
+        0xc5454a2e, 0x4502126d, 0x13a84af5, 0x93ef12b6, 0xe215dfc4, 0x62528787,
+        0x34f8df1f, 0xb4bf875c, 0x99ac6e2f, 0x19eb366c, 0x4f416ef4, 0xcf0636b7,
+        0x1566bc12, 0x9521e451, 0xc38bbcc9, 0x43cce48a, 0x6edf0df9, 0xee9855ba,
+        0xb8320d22, 0x38755561, 0xda90a835, 0x5ad7f076, 0x0c7da8ee, 0x8c3af0ad,
+        0xa12919de, 0x216e419d, 0x77c41905, 0xf7834146, 0x2de3cbe3, 0xada493a0,
+        0xfb0ecb38, 0x7b49937b, 0x565a7a08, 0xd61d224b, 0x80b77ad3, 0x00f02290,
+        0x931f3026, 0x13586865, 0x45f230fd, 0xc5b568be, 0xe8a681cd, 0x68e1d98e,
+        0x3e4b8116, 0xbe0cd955, 0x646c53f0, 0xe42b0bb3, 0xb281532b, 0x32c60b68,
+        0x1fd5e21b, 0x9f92ba58, 0xc938e2c0, 0x497fba83, 0xab9a47d7, 0x2bdd1f94,
+        0x7d77470c, 0xfd301f4f, 0xd023f63c, 0x5064ae7f, 0x06cef6e7, 0x8689aea4,
+        0x5ce92401, 0xdcae7c42, 0x8a0424da, 0x0a437c99, 0x275095ea, 0xa717cda9,
+        0xf1bd9531, 0x71facd72, 0x12480fd5, 0x920f5796, 0xc4a50f0e, 0x44e2574d,
+        0x69f1be3e, 0xe9b6e67d, 0xbf1cbee5, 0x3f5be6a6, 0xe53b6c03, 0x657c3440,
+        0x33d66cd8, 0xb391349b, 0x9e82dde8, 0x1ec585ab, 0x486fdd33, 0xc8288570,
+        0x2acd7824, 0xaa8a2067, 0xfc2078ff, 0x7c6720bc, 0x5174c9cf, 0xd133918c,
+        0x8799c914, 0x07de9157, 0xddbe1bf2, 0x5df943b1, 0x0b531b29, 0x8b14436a,
+        0xa607aa19, 0x2640f25a, 0x70eaaac2, 0xf0adf281, 0x6342e037, 0xe305b874,
+        0xb5afe0ec, 0x35e8b8af, 0x18fb51dc, 0x98bc099f, 0xce165107, 0x4e510944,
+        0x943183e1, 0x1476dba2, 0x42dc833a, 0xc29bdb79, 0xef88320a, 0x6fcf6a49,
+        0x396532d1, 0xb9226a92, 0x5bc797c6, 0xdb80cf85, 0x8d2a971d, 0x0d6dcf5e,
+        0x207e262d, 0xa0397e6e, 0xf69326f6, 0x76d47eb5, 0xacb4f410, 0x2cf3ac53,
+        0x7a59f4cb, 0xfa1eac88, 0xd70d45fb, 0x574a1db8, 0x01e04520, 0x81a71d63,
+        0xf05dd011, 0x701a8852, 0x26b0d0ca, 0xa6f78889, 0x8be461fa, 0x0ba339b9,
+        0x5d096121, 0xdd4e3962, 0x072eb3c7, 0x8769eb84, 0xd1c3b31c, 0x5184eb5f,
+        0x7c97022c, 0xfcd05a6f, 0xaa7a02f7, 0x2a3d5ab4, 0xc8d8a7e0, 0x489fffa3,
+        0x1e35a73b, 0x9e72ff78, 0xb361160b, 0x33264e48, 0x658c16d0, 0xe5cb4e93,
+        0x3fabc436, 0xbfec9c75, 0xe946c4ed, 0x69019cae, 0x441275dd, 0xc4552d9e,
+        0x92ff7506, 0x12b82d45, 0x81573ff3, 0x011067b0, 0x57ba3f28, 0xd7fd676b,
+        0xfaee8e18, 0x7aa9d65b, 0x2c038ec3, 0xac44d680, 0x76245c25, 0xf6630466,
+        0xa0c95cfe, 0x208e04bd, 0x0d9dedce, 0x8ddab58d, 0xdb70ed15, 0x5b37b556,
+        0xb9d24802, 0x39951041, 0x6f3f48d9, 0xef78109a, 0xc26bf9e9, 0x422ca1aa,
+        0x1486f932, 0x94c1a171, 0x4ea12bd4, 0xcee67397, 0x984c2b0f, 0x180b734c,
+        0x35189a3f, 0xb55fc27c, 0xe3f59ae4, 0x63b2c2a7
+    },
+    {
+        0x00000000, 0x18c5564c, 0x318aac98, 0x294ffad4, 0x63155930, 0x7bd00f7c,
+        0x529ff5a8, 0x4a5aa3e4, 0xc62ab260, 0xdeefe42c, 0xf7a01ef8, 0xef6548b4,
+        0xa53feb50, 0xbdfabd1c, 0x94b547c8, 0x8c701184, 0x5a36d49d, 0x42f382d1,
+        0x6bbc7805, 0x73792e49, 0x39238dad, 0x21e6dbe1, 0x08a92135, 0x106c7779,
+        0x9c1c66fd, 0x84d930b1, 0xad96ca65, 0xb5539c29, 0xff093fcd, 0xe7cc6981,
+        0xce839355, 0xd646c519, 0xb46da93a, 0xaca8ff76, 0x85e705a2, 0x9d2253ee,
+        0xd778f00a, 0xcfbda646, 0xe6f25c92, 0xfe370ade, 0x72471b5a, 0x6a824d16,
+        0x43cdb7c2, 0x5b08e18e, 0x1152426a, 0x09971426, 0x20d8eef2, 0x381db8be,
+        0xee5b7da7, 0xf69e2beb, 0xdfd1d13f, 0xc7148773, 0x8d4e2497, 0x958b72db,
+        0xbcc4880f, 0xa401de43, 0x2871cfc7, 0x30b4998b, 0x19fb635f, 0x013e3513,
+        0x4b6496f7, 0x53a1c0bb, 0x7aee3a6f, 0x622b6c23, 0xbeb8e229, 0xa67db465,
+        0x8f324eb1, 0x97f718fd, 0xddadbb19, 0xc568ed55, 0xec271781, 0xf4e241cd,
+        0x78925049, 0x60570605, 0x4918fcd1, 0x51ddaa9d, 0x1b870979, 0x03425f35,
+        0x2a0da5e1, 0x32c8f3ad, 0xe48e36b4, 0xfc4b60f8, 0xd5049a2c, 0xcdc1cc60,
+        0x879b6f84, 0x9f5e39c8, 0xb611c31c, 0xaed49550, 0x22a484d4, 0x3a61d298,
+        0x132e284c, 0x0beb7e00, 0x41b1dde4, 0x59748ba8, 0x703b717c, 0x68fe2730,
+        0x0ad54b13, 0x12101d5f, 0x3b5fe78b, 0x239ab1c7, 0x69c01223, 0x7105446f,
+        0x584abebb, 0x408fe8f7, 0xccfff973, 0xd43aaf3f, 0xfd7555eb, 0xe5b003a7,
+        0xafeaa043, 0xb72ff60f, 0x9e600cdb, 0x86a55a97, 0x50e39f8e, 0x4826c9c2,
+        0x61693316, 0x79ac655a, 0x33f6c6be, 0x2b3390f2, 0x027c6a26, 0x1ab93c6a,
+        0x96c92dee, 0x8e0c7ba2, 0xa7438176, 0xbf86d73a, 0xf5dc74de, 0xed192292,
+        0xc456d846, 0xdc938e0a, 0xab12740f, 0xb3d72243, 0x9a98d897, 0x825d8edb,
+        0xc8072d3f, 0xd0c27b73, 0xf98d81a7, 0xe148d7eb, 0x6d38c66f, 0x75fd9023,
+        0x5cb26af7, 0x44773cbb, 0x0e2d9f5f, 0x16e8c913, 0x3fa733c7, 0x2762658b,
+        0xf124a092, 0xe9e1f6de, 0xc0ae0c0a, 0xd86b5a46, 0x9231f9a2, 0x8af4afee,
+        0xa3bb553a, 0xbb7e0376, 0x370e12f2, 0x2fcb44be, 0x0684be6a, 0x1e41e826,
+        0x541b4bc2, 0x4cde1d8e, 0x6591e75a, 0x7d54b116, 0x1f7fdd35, 0x07ba8b79,
+        0x2ef571ad, 0x363027e1, 0x7c6a8405, 0x64afd249, 0x4de0289d, 0x55257ed1,
+        0xd9556f55, 0xc1903919, 0xe8dfc3cd, 0xf01a9581, 0xba403665, 0xa2856029,
+        0x8bca9afd, 0x930fccb1, 0x454909a8, 0x5d8c5fe4, 0x74c3a530, 0x6c06f37c,
+        0x265c5098, 0x3e9906d4, 0x17d6fc00, 0x0f13aa4c, 0x8363bbc8, 0x9ba6ed84,
+        0xb2e91750, 0xaa2c411c, 0xe076e2f8, 0xf8b3b4b4, 0xd1fc4e60, 0xc939182c,
+        0x15aa9626, 0x0d6fc06a, 0x24203abe, 0x3ce56cf2, 0x76bfcf16, 0x6e7a995a,
+        0x4735638e, 0x5ff035c2, 0xd3802446, 0xcb45720a, 0xe20a88de, 0xfacfde92,
+        0xb0957d76, 0xa8502b3a, 0x811fd1ee, 0x99da87a2, 0x4f9c42bb, 0x575914f7,
+        0x7e16ee23, 0x66d3b86f, 0x2c891b8b, 0x344c4dc7, 0x1d03b713, 0x05c6e15f,
+        0x89b6f0db, 0x9173a697, 0xb83c5c43, 0xa0f90a0f, 0xeaa3a9eb, 0xf266ffa7,
+        0xdb290573, 0xc3ec533f, 0xa1c73f1c, 0xb9026950, 0x904d9384, 0x8888c5c8,
+        0xc2d2662c, 0xda173060, 0xf358cab4, 0xeb9d9cf8, 0x67ed8d7c, 0x7f28db30,
+        0x566721e4, 0x4ea277a8, 0x04f8d44c, 0x1c3d8200, 0x357278d4, 0x2db72e98,
+        0xfbf1eb81, 0xe334bdcd, 0xca7b4719, 0xd2be1155, 0x98e4b2b1, 0x8021e4fd,
+        0xa96e1e29, 0xb1ab4865, 0x3ddb59e1, 0x251e0fad, 0x0c51f579, 0x1494a335,
+        0x5ece00d1, 0x460b569d, 0x6f44ac49, 0x7781fa05
+    },
+    {
+        0x00000000, 0x14946d10, 0x2928da20, 0x3dbcb730, 0x5251b440, 0x46c5d950,
+        0x7b796e60, 0x6fed0370, 0xa4a36880, 0xb0370590, 0x8d8bb2a0, 0x991fdfb0,
+        0xf6f2dcc0, 0xe266b1d0, 0xdfda06e0, 0xcb4e6bf0, 0x9f25615d, 0x8bb10c4d,
+        0xb60dbb7d, 0xa299d66d, 0xcd74d51d, 0xd9e0b80d, 0xe45c0f3d, 0xf0c8622d,
+        0x3b8609dd, 0x2f1264cd, 0x12aed3fd, 0x063abeed, 0x69d7bd9d, 0x7d43d08d,
+        0x40ff67bd, 0x546b0aad, 0xe82972e7, 0xfcbd1ff7, 0xc101a8c7, 0xd595c5d7,
+        0xba78c6a7, 0xaeecabb7, 0x93501c87, 0x87c47197, 0x4c8a1a67, 0x581e7777,
+        0x65a2c047, 0x7136ad57, 0x1edbae27, 0x0a4fc337, 0x37f37407, 0x23671917,
+        0x770c13ba, 0x63987eaa, 0x5e24c99a, 0x4ab0a48a, 0x255da7fa, 0x31c9caea,
+        0x0c757dda, 0x18e110ca, 0xd3af7b3a, 0xc73b162a, 0xfa87a11a, 0xee13cc0a,
+        0x81fecf7a, 0x956aa26a, 0xa8d6155a, 0xbc42784a, 0x06315593, 0x12a53883,
+        0x2f198fb3, 0x3b8de2a3, 0x5460e1d3, 0x40f48cc3, 0x7d483bf3, 0x69dc56e3,
+        0xa2923d13, 0xb6065003, 0x8bbae733, 0x9f2e8a23, 0xf0c38953, 0xe457e443,
+        0xd9eb5373, 0xcd7f3e63, 0x991434ce, 0x8d8059de, 0xb03ceeee, 0xa4a883fe,
+        0xcb45808e, 0xdfd1ed9e, 0xe26d5aae, 0xf6f937be, 0x3db75c4e, 0x2923315e,
+        0x149f866e, 0x000beb7e, 0x6fe6e80e, 0x7b72851e, 0x46ce322e, 0x525a5f3e,
+        0xee182774, 0xfa8c4a64, 0xc730fd54, 0xd3a49044, 0xbc499334, 0xa8ddfe24,
+        0x95614914, 0x81f52404, 0x4abb4ff4, 0x5e2f22e4, 0x639395d4, 0x7707f8c4,
+        0x18eafbb4, 0x0c7e96a4, 0x31c22194, 0x25564c84, 0x713d4629, 0x65a92b39,
+        0x58159c09, 0x4c81f119, 0x236cf269, 0x37f89f79, 0x0a442849, 0x1ed04559,
+        0xd59e2ea9, 0xc10a43b9, 0xfcb6f489, 0xe8229999, 0x87cf9ae9, 0x935bf7f9,
+        0xaee740c9, 0xba732dd9, 0x0c62ab26, 0x18f6c636, 0x254a7106, 0x31de1c16,
+        0x5e331f66, 0x4aa77276, 0x771bc546, 0x638fa856, 0xa8c1c3a6, 0xbc55aeb6,
+        0x81e91986, 0x957d7496, 0xfa9077e6, 0xee041af6, 0xd3b8adc6, 0xc72cc0d6,
+        0x9347ca7b, 0x87d3a76b, 0xba6f105b, 0xaefb7d4b, 0xc1167e3b, 0xd582132b,
+        0xe83ea41b, 0xfcaac90b, 0x37e4a2fb, 0x2370cfeb, 0x1ecc78db, 0x0a5815cb,
+        0x65b516bb, 0x71217bab, 0x4c9dcc9b, 0x5809a18b, 0xe44bd9c1, 0xf0dfb4d1,
+        0xcd6303e1, 0xd9f76ef1, 0xb61a6d81, 0xa28e0091, 0x9f32b7a1, 0x8ba6dab1,
+        0x40e8b141, 0x547cdc51, 0x69c06b61, 0x7d540671, 0x12b90501, 0x062d6811,
+        0x3b91df21, 0x2f05b231, 0x7b6eb89c, 0x6ffad58c, 0x524662bc, 0x46d20fac,
+        0x293f0cdc, 0x3dab61cc, 0x0017d6fc, 0x1483bbec, 0xdfcdd01c, 0xcb59bd0c,
+        0xf6e50a3c, 0xe271672c, 0x8d9c645c, 0x9908094c, 0xa4b4be7c, 0xb020d36c,
+        0x0a53feb5, 0x1ec793a5, 0x237b2495, 0x37ef4985, 0x58024af5, 0x4c9627e5,
+        0x712a90d5, 0x65befdc5, 0xaef09635, 0xba64fb25, 0x87d84c15, 0x934c2105,
+        0xfca12275, 0xe8354f65, 0xd589f855, 0xc11d9545, 0x95769fe8, 0x81e2f2f8,
+        0xbc5e45c8, 0xa8ca28d8, 0xc7272ba8, 0xd3b346b8, 0xee0ff188, 0xfa9b9c98,
+        0x31d5f768, 0x25419a78, 0x18fd2d48, 0x0c694058, 0x63844328, 0x77102e38,
+        0x4aac9908, 0x5e38f418, 0xe27a8c52, 0xf6eee142, 0xcb525672, 0xdfc63b62,
+        0xb02b3812, 0xa4bf5502, 0x9903e232, 0x8d978f22, 0x46d9e4d2, 0x524d89c2,
+        0x6ff13ef2, 0x7b6553e2, 0x14885092, 0x001c3d82, 0x3da08ab2, 0x2934e7a2,
+        0x7d5fed0f, 0x69cb801f, 0x5477372f, 0x40e35a3f, 0x2f0e594f, 0x3b9a345f,
+        0x0626836f, 0x12b2ee7f, 0xd9fc858f, 0xcd68e89f, 0xf0d45faf, 0xe44032bf,
+        0x8bad31cf, 0x9f395cdf, 0xa285ebef, 0xb61186ff
+    },
+    {
+        0x00000000, 0x83db9b51, 0xd1d486ff, 0x520f1dae, 0x75cabda3, 0xf61126f2,
+        0xa41e3b5c, 0x27c5a00d, 0xeb957b46, 0x684ee017, 0x3a41fdb9, 0xb99a66e8,
+        0x9e5fc6e5, 0x1d845db4, 0x4f8b401a, 0xcc50db4b, 0x014946d1, 0x8292dd80,
+        0xd09dc02e, 0x53465b7f, 0x7483fb72, 0xf7586023, 0xa5577d8d, 0x268ce6dc,
+        0xeadc3d97, 0x6907a6c6, 0x3b08bb68, 0xb8d32039, 0x9f168034, 0x1ccd1b65,
+        0x4ec206cb, 0xcd199d9a, 0x02928da2, 0x814916f3, 0xd3460b5d, 0x509d900c,
+        0x77583001, 0xf483ab50, 0xa68cb6fe, 0x25572daf, 0xe907f6e4, 0x6adc6db5,
+        0x38d3701b, 0xbb08eb4a, 0x9ccd4b47, 0x1f16d016, 0x4d19cdb8, 0xcec256e9,
+        0x03dbcb73, 0x80005022, 0xd20f4d8c, 0x51d4d6dd, 0x761176d0, 0xf5caed81,
+        0xa7c5f02f, 0x241e6b7e, 0xe84eb035, 0x6b952b64, 0x399a36ca, 0xba41ad9b,
+        0x9d840d96, 0x1e5f96c7, 0x4c508b69, 0xcf8b1038, 0x05251b44, 0x86fe8015,
+        0xd4f19dbb, 0x572a06ea, 0x70efa6e7, 0xf3343db6, 0xa13b2018, 0x22e0bb49,
+        0xeeb06002, 0x6d6bfb53, 0x3f64e6fd, 0xbcbf7dac, 0x9b7adda1, 0x18a146f0,
+        0x4aae5b5e, 0xc975c00f, 0x046c5d95, 0x87b7c6c4, 0xd5b8db6a, 0x5663403b,
+        0x71a6e036, 0xf27d7b67, 0xa07266c9, 0x23a9fd98, 0xeff926d3, 0x6c22bd82,
+        0x3e2da02c, 0xbdf63b7d, 0x9a339b70, 0x19e80021, 0x4be71d8f, 0xc83c86de,
+        0x07b796e6, 0x846c0db7, 0xd6631019, 0x55b88b48, 0x727d2b45, 0xf1a6b014,
+        0xa3a9adba, 0x207236eb, 0xec22eda0, 0x6ff976f1, 0x3df66b5f, 0xbe2df00e,
+        0x99e85003, 0x1a33cb52, 0x483cd6fc, 0xcbe74dad, 0x06fed037, 0x85254b66,
+        0xd72a56c8, 0x54f1cd99, 0x73346d94, 0xf0eff6c5, 0xa2e0eb6b, 0x213b703a,
+        0xed6bab71, 0x6eb03020, 0x3cbf2d8e, 0xbf64b6df, 0x98a116d2, 0x1b7a8d83,
+        0x4975902d, 0xcaae0b7c, 0x0a4a3688, 0x8991add9, 0xdb9eb077, 0x58452b26,
+        0x7f808b2b, 0xfc5b107a, 0xae540dd4, 0x2d8f9685, 0xe1df4dce, 0x6204d69f,
+        0x300bcb31, 0xb3d05060, 0x9415f06d, 0x17ce6b3c, 0x45c17692, 0xc61aedc3,
+        0x0b037059, 0x88d8eb08, 0xdad7f6a6, 0x590c6df7, 0x7ec9cdfa, 0xfd1256ab,
+        0xaf1d4b05, 0x2cc6d054, 0xe0960b1f, 0x634d904e, 0x31428de0, 0xb29916b1,
+        0x955cb6bc, 0x16872ded, 0x44883043, 0xc753ab12, 0x08d8bb2a, 0x8b03207b,
+        0xd90c3dd5, 0x5ad7a684, 0x7d120689, 0xfec99dd8, 0xacc68076, 0x2f1d1b27,
+        0xe34dc06c, 0x60965b3d, 0x32994693, 0xb142ddc2, 0x96877dcf, 0x155ce69e,
+        0x4753fb30, 0xc4886061, 0x0991fdfb, 0x8a4a66aa, 0xd8457b04, 0x5b9ee055,
+        0x7c5b4058, 0xff80db09, 0xad8fc6a7, 0x2e545df6, 0xe20486bd, 0x61df1dec,
+        0x33d00042, 0xb00b9b13, 0x97ce3b1e, 0x1415a04f, 0x461abde1, 0xc5c126b0,
+        0x0f6f2dcc, 0x8cb4b69d, 0xdebbab33, 0x5d603062, 0x7aa5906f, 0xf97e0b3e,
+        0xab711690, 0x28aa8dc1, 0xe4fa568a, 0x6721cddb, 0x352ed075, 0xb6f54b24,
+        0x9130eb29, 0x12eb7078, 0x40e46dd6, 0xc33ff687, 0x0e266b1d, 0x8dfdf04c,
+        0xdff2ede2, 0x5c2976b3, 0x7becd6be, 0xf8374def, 0xaa385041, 0x29e3cb10,
+        0xe5b3105b, 0x66688b0a, 0x346796a4, 0xb7bc0df5, 0x9079adf8, 0x13a236a9,
+        0x41ad2b07, 0xc276b056, 0x0dfda06e, 0x8e263b3f, 0xdc292691, 0x5ff2bdc0,
+        0x78371dcd, 0xfbec869c, 0xa9e39b32, 0x2a380063, 0xe668db28, 0x65b34079,
+        0x37bc5dd7, 0xb467c686, 0x93a2668b, 0x1079fdda, 0x4276e074, 0xc1ad7b25,
+        0x0cb4e6bf, 0x8f6f7dee, 0xdd606040, 0x5ebbfb11, 0x797e5b1c, 0xfaa5c04d,
+        0xa8aadde3, 0x2b7146b2, 0xe7219df9, 0x64fa06a8, 0x36f51b06, 0xb52e8057,
+        0x92eb205a, 0x1130bb0b, 0x433fa6a5, 0xc0e43df4
+    },
+    {
+        0x00000000, 0x6041fc7a, 0xc083f8f4, 0xa0c2048e, 0x576441b5, 0x3725bdcf,
+        0x97e7b941, 0xf7a6453b, 0xaec8836a, 0xce897f10, 0x6e4b7b9e, 0x0e0a87e4,
+        0xf9acc2df, 0x99ed3ea5, 0x392f3a2b, 0x596ec651, 0x8bf2b689, 0xebb34af3,
+        0x4b714e7d, 0x2b30b207, 0xdc96f73c, 0xbcd70b46, 0x1c150fc8, 0x7c54f3b2,
+        0x253a35e3, 0x457bc999, 0xe5b9cd17, 0x85f8316d, 0x725e7456, 0x121f882c,
+        0xb2dd8ca2, 0xd29c70d8, 0xc186dd4f, 0xa1c72135, 0x010525bb, 0x6144d9c1,
+        0x96e29cfa, 0xf6a36080, 0x5661640e, 0x36209874, 0x6f4e5e25, 0x0f0fa25f,
+        0xafcda6d1, 0xcf8c5aab, 0x382a1f90, 0x586be3ea, 0xf8a9e764, 0x98e81b1e,
+        0x4a746bc6, 0x2a3597bc, 0x8af79332, 0xeab66f48, 0x1d102a73, 0x7d51d609,
+        0xdd93d287, 0xbdd22efd, 0xe4bce8ac, 0x84fd14d6, 0x243f1058, 0x447eec22,
+        0xb3d8a919, 0xd3995563, 0x735b51ed, 0x131aad97, 0x556e0ac3, 0x352ff6b9,
+        0x95edf237, 0xf5ac0e4d, 0x020a4b76, 0x624bb70c, 0xc289b382, 0xa2c84ff8,
+        0xfba689a9, 0x9be775d3, 0x3b25715d, 0x5b648d27, 0xacc2c81c, 0xcc833466,
+        0x6c4130e8, 0x0c00cc92, 0xde9cbc4a, 0xbedd4030, 0x1e1f44be, 0x7e5eb8c4,
+        0x89f8fdff, 0xe9b90185, 0x497b050b, 0x293af971, 0x70543f20, 0x1015c35a,
+        0xb0d7c7d4, 0xd0963bae, 0x27307e95, 0x477182ef, 0xe7b38661, 0x87f27a1b,
+        0x94e8d78c, 0xf4a92bf6, 0x546b2f78, 0x342ad302, 0xc38c9639, 0xa3cd6a43,
+        0x030f6ecd, 0x634e92b7, 0x3a2054e6, 0x5a61a89c, 0xfaa3ac12, 0x9ae25068,
+        0x6d441553, 0x0d05e929, 0xadc7eda7, 0xcd8611dd, 0x1f1a6105, 0x7f5b9d7f,
+        0xdf9999f1, 0xbfd8658b, 0x487e20b0, 0x283fdcca, 0x88fdd844, 0xe8bc243e,
+        0xb1d2e26f, 0xd1931e15, 0x71511a9b, 0x1110e6e1, 0xe6b6a3da, 0x86f75fa0,
+        0x26355b2e, 0x4674a754, 0xaadc1586, 0xca9de9fc, 0x6a5fed72, 0x0a1e1108,
+        0xfdb85433, 0x9df9a849, 0x3d3bacc7, 0x5d7a50bd, 0x041496ec, 0x64556a96,
+        0xc4976e18, 0xa4d69262, 0x5370d759, 0x33312b23, 0x93f32fad, 0xf3b2d3d7,
+        0x212ea30f, 0x416f5f75, 0xe1ad5bfb, 0x81eca781, 0x764ae2ba, 0x160b1ec0,
+        0xb6c91a4e, 0xd688e634, 0x8fe62065, 0xefa7dc1f, 0x4f65d891, 0x2f2424eb,
+        0xd88261d0, 0xb8c39daa, 0x18019924, 0x7840655e, 0x6b5ac8c9, 0x0b1b34b3,
+        0xabd9303d, 0xcb98cc47, 0x3c3e897c, 0x5c7f7506, 0xfcbd7188, 0x9cfc8df2,
+        0xc5924ba3, 0xa5d3b7d9, 0x0511b357, 0x65504f2d, 0x92f60a16, 0xf2b7f66c,
+        0x5275f2e2, 0x32340e98, 0xe0a87e40, 0x80e9823a, 0x202b86b4, 0x406a7ace,
+        0xb7cc3ff5, 0xd78dc38f, 0x774fc701, 0x170e3b7b, 0x4e60fd2a, 0x2e210150,
+        0x8ee305de, 0xeea2f9a4, 0x1904bc9f, 0x794540e5, 0xd987446b, 0xb9c6b811,
+        0xffb21f45, 0x9ff3e33f, 0x3f31e7b1, 0x5f701bcb, 0xa8d65ef0, 0xc897a28a,
+        0x6855a604, 0x08145a7e, 0x517a9c2f, 0x313b6055, 0x91f964db, 0xf1b898a1,
+        0x061edd9a, 0x665f21e0, 0xc69d256e, 0xa6dcd914, 0x7440a9cc, 0x140155b6,
+        0xb4c35138, 0xd482ad42, 0x2324e879, 0x43651403, 0xe3a7108d, 0x83e6ecf7,
+        0xda882aa6, 0xbac9d6dc, 0x1a0bd252, 0x7a4a2e28, 0x8dec6b13, 0xedad9769,
+        0x4d6f93e7, 0x2d2e6f9d, 0x3e34c20a, 0x5e753e70, 0xfeb73afe, 0x9ef6c684,
+        0x695083bf, 0x09117fc5, 0xa9d37b4b, 0xc9928731, 0x90fc4160, 0xf0bdbd1a,
+        0x507fb994, 0x303e45ee, 0xc79800d5, 0xa7d9fcaf, 0x071bf821, 0x675a045b,
+        0xb5c67483, 0xd58788f9, 0x75458c77, 0x1504700d, 0xe2a23536, 0x82e3c94c,
+        0x2221cdc2, 0x426031b8, 0x1b0ef7e9, 0x7b4f0b93, 0xdb8d0f1d, 0xbbccf367,
+        0x4c6ab65c, 0x2c2b4a26, 0x8ce94ea8, 0xeca8b2d2
+    },
+    {
+        0x00000000, 0x9d65b2a5, 0xeca8d517, 0x71cd67b2, 0x0f321a73, 0x9257a8d6,
+        0xe39acf64, 0x7eff7dc1, 0x1e6434e6, 0x83018643, 0xf2cce1f1, 0x6fa95354,
+        0x11562e95, 0x8c339c30, 0xfdfefb82, 0x609b4927, 0x3cc869cc, 0xa1addb69,
+        0xd060bcdb, 0x4d050e7e, 0x33fa73bf, 0xae9fc11a, 0xdf52a6a8, 0x4237140d,
+        0x22ac5d2a, 0xbfc9ef8f, 0xce04883d, 0x53613a98, 0x2d9e4759, 0xb0fbf5fc,
+        0xc136924e, 0x5c5320eb, 0x7990d398, 0xe4f5613d, 0x9538068f, 0x085db42a,
+        0x76a2c9eb, 0xebc77b4e, 0x9a0a1cfc, 0x076fae59, 0x67f4e77e, 0xfa9155db,
+        0x8b5c3269, 0x163980cc, 0x68c6fd0d, 0xf5a34fa8, 0x846e281a, 0x190b9abf,
+        0x4558ba54, 0xd83d08f1, 0xa9f06f43, 0x3495dde6, 0x4a6aa027, 0xd70f1282,
+        0xa6c27530, 0x3ba7c795, 0x5b3c8eb2, 0xc6593c17, 0xb7945ba5, 0x2af1e900,
+        0x540e94c1, 0xc96b2664, 0xb8a641d6, 0x25c3f373, 0xf321a730, 0x6e441595,
+        0x1f897227, 0x82ecc082, 0xfc13bd43, 0x61760fe6, 0x10bb6854, 0x8ddedaf1,
+        0xed4593d6, 0x70202173, 0x01ed46c1, 0x9c88f464, 0xe27789a5, 0x7f123b00,
+        0x0edf5cb2, 0x93baee17, 0xcfe9cefc, 0x528c7c59, 0x23411beb, 0xbe24a94e,
+        0xc0dbd48f, 0x5dbe662a, 0x2c730198, 0xb116b33d, 0xd18dfa1a, 0x4ce848bf,
+        0x3d252f0d, 0xa0409da8, 0xdebfe069, 0x43da52cc, 0x3217357e, 0xaf7287db,
+        0x8ab174a8, 0x17d4c60d, 0x6619a1bf, 0xfb7c131a, 0x85836edb, 0x18e6dc7e,
+        0x692bbbcc, 0xf44e0969, 0x94d5404e, 0x09b0f2eb, 0x787d9559, 0xe51827fc,
+        0x9be75a3d, 0x0682e898, 0x774f8f2a, 0xea2a3d8f, 0xb6791d64, 0x2b1cafc1,
+        0x5ad1c873, 0xc7b47ad6, 0xb94b0717, 0x242eb5b2, 0x55e3d200, 0xc88660a5,
+        0xa81d2982, 0x35789b27, 0x44b5fc95, 0xd9d04e30, 0xa72f33f1, 0x3a4a8154,
+        0x4b87e6e6, 0xd6e25443, 0x3020fe3d, 0xad454c98, 0xdc882b2a, 0x41ed998f,
+        0x3f12e44e, 0xa27756eb, 0xd3ba3159, 0x4edf83fc, 0x2e44cadb, 0xb321787e,
+        0xc2ec1fcc, 0x5f89ad69, 0x2176d0a8, 0xbc13620d, 0xcdde05bf, 0x50bbb71a,
+        0x0ce897f1, 0x918d2554, 0xe04042e6, 0x7d25f043, 0x03da8d82, 0x9ebf3f27,
+        0xef725895, 0x7217ea30, 0x128ca317, 0x8fe911b2, 0xfe247600, 0x6341c4a5,
+        0x1dbeb964, 0x80db0bc1, 0xf1166c73, 0x6c73ded6, 0x49b02da5, 0xd4d59f00,
+        0xa518f8b2, 0x387d4a17, 0x468237d6, 0xdbe78573, 0xaa2ae2c1, 0x374f5064,
+        0x57d41943, 0xcab1abe6, 0xbb7ccc54, 0x26197ef1, 0x58e60330, 0xc583b195,
+        0xb44ed627, 0x292b6482, 0x75784469, 0xe81df6cc, 0x99d0917e, 0x04b523db,
+        0x7a4a5e1a, 0xe72fecbf, 0x96e28b0d, 0x0b8739a8, 0x6b1c708f, 0xf679c22a,
+        0x87b4a598, 0x1ad1173d, 0x642e6afc, 0xf94bd859, 0x8886bfeb, 0x15e30d4e,
+        0xc301590d, 0x5e64eba8, 0x2fa98c1a, 0xb2cc3ebf, 0xcc33437e, 0x5156f1db,
+        0x209b9669, 0xbdfe24cc, 0xdd656deb, 0x4000df4e, 0x31cdb8fc, 0xaca80a59,
+        0xd2577798, 0x4f32c53d, 0x3effa28f, 0xa39a102a, 0xffc930c1, 0x62ac8264,
+        0x1361e5d6, 0x8e045773, 0xf0fb2ab2, 0x6d9e9817, 0x1c53ffa5, 0x81364d00,
+        0xe1ad0427, 0x7cc8b682, 0x0d05d130, 0x90606395, 0xee9f1e54, 0x73faacf1,
+        0x0237cb43, 0x9f5279e6, 0xba918a95, 0x27f43830, 0x56395f82, 0xcb5ced27,
+        0xb5a390e6, 0x28c62243, 0x590b45f1, 0xc46ef754, 0xa4f5be73, 0x39900cd6,
+        0x485d6b64, 0xd538d9c1, 0xabc7a400, 0x36a216a5, 0x476f7117, 0xda0ac3b2,
+        0x8659e359, 0x1b3c51fc, 0x6af1364e, 0xf79484eb, 0x896bf92a, 0x140e4b8f,
+        0x65c32c3d, 0xf8a69e98, 0x983dd7bf, 0x0558651a, 0x749502a8, 0xe9f0b00d,
+        0x970fcdcc, 0x0a6a7f69, 0x7ba718db, 0xe6c2aa7e
+    }
+};
+#endif
+
+/**
+ * @brief Accumulate a buffer of octets into the CRC in "crc32kValue".
+ * @param buffer - octets to accumulate
+ * @param length - number of octets in the buffer
+ * @param crc32kValue accumulated value equivalent to four octets.
+ * @return value is updated CRC, equal to calling cobs_crc32k()
+ *  for each octet in the buffer
+ * @note When CRC_USE_SLICE_BY_8 is defined, eight octets are
+ *  folded into the CRC per round using 8KB of constant tables.
+ */
+uint32_t
+cobs_crc32k_buffer(const uint8_t *buffer, size_t length, uint32_t crc32kValue)
+{
+    uint32_t crc = crc32kValue;
+
+    if (!buffer) {
+        return crc;
+    }
+#if defined(CRC_USE_SLICE_BY_8)
+    while (length >= 8) {
+        crc ^= (uint32_t)buffer[0] | ((uint32_t)buffer[1] << 8) |
+            ((uint32_t)buffer[2] << 16) | ((uint32_t)buffer[3] << 24);
+        crc = CRC32K_Slice[7][crc & 0xFF] ^ CRC32K_Slice[6][(crc >> 8) & 0xFF] ^
+            CRC32K_Slice[5][(crc >> 16) & 0xFF] ^ CRC32K_Slice[4][crc >> 24] ^
+            CRC32K_Slice[3][buffer[4]] ^ CRC32K_Slice[2][buffer[5]] ^
+            CRC32K_Slice[1][buffer[6]] ^ CRC32K_Slice[0][buffer[7]];
+        buffer += 8;
+        length -= 8;
+    }
+    while (length > 0) {
+        crc = (crc >> 8) ^ CRC32K_Slice[0][(crc ^ *buffer) & 0xFF];
+        buffer++;
+        length--;
+    }
+#else
+    while (length > 0) {
+        crc = cobs_crc32k(*buffer, crc);
+        buffer++;
+        length--;
+    }
+#endif
+
+    return crc;
+}
+
 /**
  * @brief Encodes 'length' octets of data located at 'from' and
  * writes one or more COBS code blocks at 'buffer', removing
@@ -155,7 +568,6 @@ size_t cobs_frame_encode(
     size_t cobs_data_len, cobs_crc_len;
     uint32_t crc32K;
     uint8_t crc_buffer[4];
-    int i;
 
     /*
      * Prepare the Encoded Data field for transmission.
@@ -169,10 +581,8 @@ size_t cobs_frame_encode(
      * Calculate CRC-32K over the Encoded Data field.
      * NOTE: May be done as each octet is transmitted to reduce latency.
      */
-    crc32K = CRC32K_INITIAL_VALUE;
-    for (i = 0; i < cobs_data_len; i++) {
-        crc32K = cobs_crc32k(buffer[i], crc32K); /* See Clause G.3.1 */
-    }
+    /* See Clause G.3.1 */
+    crc32K = cobs_crc32k_buffer(buffer, cobs_data_len, CRC32K_INITIAL_VALUE);
     /*
      * Prepare the Encoded CRC-32K field for transmission.
      */
@@ -271,7 +681,6 @@ size_t cobs_frame_decode(
     size_t data_len, crc_len;
     uint32_t crc32K;
     uint8_t crc_buffer[4];
-    int i;
 
     if (length < COBS_ENCODED_CRC_SIZE) {
         /* error during decode */
@@ -282,11 +691,8 @@ size_t cobs_frame_decode(
      * NOTE: Adjust 'length' by removing size of Encoded CRC-32K field.
      */
     data_len = length - COBS_ENCODED_CRC_SIZE;
-    crc32K = CRC32K_INITIAL_VALUE;
-    for (i = 0; i < data_len; i++) {
-        /* See Clause G.3.1 */
-        crc32K = cobs_crc32k(from[i], crc32K);
-    }
+    /* See Clause G.3.1 */
+    crc32K = cobs_crc32k_buffer(from, data_len, CRC32K_INITIAL_VALUE);
     data_len =
         cobs_decode(buffer, buffer_size, from, data_len, MSTP_PREAMBLE_X55);
     if (data_len == 0) {
@@ -308,9 +714,7 @@ size_t cobs_frame_decode(
     /*
      * Continue to verify CRC32K of incoming frame.
      */
-    for (i = 0; i < crc_len; i++) {
-        crc32K = cobs_crc32k(crc_buffer[i], crc32K);
-    }
+    crc32K = cobs_crc32k_buffer(crc_buffer, crc_len, crc32K);
     if (crc32K == CRC32K_RESIDUE) {
         return data_len;
     }
@@ -33,19 +33,6 @@ typedef struct dlmstp_packet {
     uint8_t pdu[DLMSTP_MPDU_MAX]; /* packet */
 } DLMSTP_PACKET;
 
-/* container for packet and token statistics */
-typedef struct dlmstp_statistics {
-    uint32_t transmit_frame_counter;
-    uint32_t receive_valid_frame_counter;
-    uint32_t receive_invalid_frame_counter;
-    uint32_t receive_valid_frame_not_for_us_counter;
-    uint32_t transmit_pdu_counter;
-    uint32_t receive_pdu_counter;
-    uint32_t lost_token_counter;
-    uint32_t bad_crc_counter;
-    uint32_t poll_for_master_counter;
-} DLMSTP_STATISTICS;
-
 #ifndef DLMSTP_MAX_INFO_FRAMES
 #define DLMSTP_MAX_INFO_FRAMES DEFAULT_MAX_INFO_FRAMES
 #endif
@@ -145,6 +132,10 @@ uint16_t dlmstp_receive(
     uint8_t *pdu, /* PDU data */
     uint16_t max_pdu, /* amount of space available in the PDU  */
     unsigned timeout); /* milliseconds to wait for a packet */
+/* descriptor readable while a received packet is waiting, or -1.
+   Only provided by ports with an event loop, such as Linux. */
+BACNET_STACK_EXPORT
+int dlmstp_receive_fd(void);
 
 /* This parameter represents the value of the Max_Info_Frames property of */
 /* the node's Device object. The value of Max_Info_Frames specifies the */
@@ -218,26 +218,21 @@ uint16_t MSTP_Create_Frame(
         if ((8 + data_len + 2) > buffer_size) {
             return 0;
         }
-        for (index = 8; index < (data_len + 8); index++, data++) {
-            buffer[index] = *data;
-            crc16 = CRC_Calc_Data(buffer[index], crc16);
-        }
+        memmove(&buffer[8], data, data_len);
+        crc16 = CRC_Calc_Data_Buffer(&buffer[8], data_len, crc16);
         crc16 = ~crc16;
+        index = 8 + data_len;
         buffer[index] = crc16 & 0xFF; /* LSB first */
         buffer[index + 1] = crc16 >> 8;
     }
     buffer[0] = 0x55;
     buffer[1] = 0xFF;
     buffer[2] = frame_type;
-    crc8 = CRC_Calc_Header(buffer[2], crc8);
     buffer[3] = destination;
-    crc8 = CRC_Calc_Header(buffer[3], crc8);
     buffer[4] = source;
-    crc8 = CRC_Calc_Header(buffer[4], crc8);
     buffer[5] = data_len >> 8; /* MSB first */
-    crc8 = CRC_Calc_Header(buffer[5], crc8);
     buffer[6] = data_len & 0xFF;
-    crc8 = CRC_Calc_Header(buffer[6], crc8);
+    crc8 = CRC_Calc_Header_Buffer(&buffer[2], 5, crc8);
     buffer[7] = ~crc8;
     index = 8;
     if (data_len > 0) {
@@ -631,6 +626,151 @@ void MSTP_Receive_Frame_FSM(struct mstp_port_struct_t *mstp_port)
     return;
 }
 
+/**
+ * @brief Check if the receive state machine has a frame to be handled
+ * @param mstp_port MSTP port context data
+ * @return true if a valid or invalid frame was received
+ */
+static bool MSTP_Frame_Received(const struct mstp_port_struct_t *mstp_port)
+{
+    return mstp_port->ReceivedValidFrame ||
+        mstp_port->ReceivedValidFrameNotForUs ||
+        mstp_port->ReceivedInvalidFrame;
+}
+
+/**
+ * @brief Add a number of events to the EventCount, limited to 255
+ * @param mstp_port MSTP port context data
+ * @param count number of events
+ */
+static void
+MSTP_Event_Count_Add(struct mstp_port_struct_t *mstp_port, size_t count)
+{
+    if (count >= (size_t)(0xFF - mstp_port->EventCount)) {
+        mstp_port->EventCount = 0xFF;
+    } else {
+        mstp_port->EventCount += (uint8_t)count;
+    }
+}
+
+/**
+ * @brief Receive a block of octets with the receive state machine.
+ *  The octets are handled as a span where the state machine would only
+ *  wait for more octets: the idle line is scanned for the preamble,
+ *  the fixed header is gathered with its CRC, and the data of a frame
+ *  is copied and checked with its CRC in one pass.  Everything else is
+ *  handled by MSTP_Receive_Frame_FSM() an octet at a time, which is
+ *  still the receive state machine used by ports that receive an octet
+ *  per interrupt.
+ * @param mstp_port MSTP port context data
+ * @param buffer received octets
+ * @param length number of received octets
+ * @return number of octets used, which is less than length when a frame
+ *  was received and needs to be handled before the remaining octets.
+ */
+size_t MSTP_Receive_Frame_Buffer(
+    struct mstp_port_struct_t *mstp_port, const uint8_t *buffer, size_t length)
+{
+    const uint8_t *preamble;
+    size_t offset = 0;
+    size_t count, copy_count;
+    uint8_t data;
+
+    if (!mstp_port || !buffer) {
+        return 0;
+    }
+    while ((offset < length) && !MSTP_Frame_Received(mstp_port)) {
+        if (mstp_port->ReceiveError || mstp_port->DataAvailable) {
+            /* the state machine handles an error or an earlier octet */
+            MSTP_Receive_Frame_FSM(mstp_port);
+            continue;
+        }
+        if (mstp_port->receive_state == MSTP_RECEIVE_STATE_IDLE) {
+            preamble = memchr(&buffer[offset], 0x55, length - offset);
+            if (preamble) {
+                count = (size_t)(preamble - &buffer[offset]);
+            } else {
+                count = length - offset;
+            }
+            if (count > 0) {
+                /* EatAnOctet for each octet before the preamble */
+                offset += count;
+                MSTP_Event_Count_Add(mstp_port, count);
+                mstp_port->SilenceTimerReset((void *)mstp_port);
+                continue;
+            }
+        } else if (
+            (mstp_port->receive_state == MSTP_RECEIVE_STATE_HEADER) &&
+            (mstp_port->Index < 5) &&
+            (mstp_port->SilenceTimer((void *)mstp_port) <=
+             mstp_port->Tframe_abort)) {
+            /* FrameType, Destination, Source, Length1, and Length2.
+               The HeaderCRC octet is left for the state machine. */
+            count = 0;
+            while ((mstp_port->Index < 5) && (offset < length)) {
+                data = buffer[offset];
+                mstp_port->HeaderCRC =
+                    CRC_Calc_Header(data, mstp_port->HeaderCRC);
+                if (mstp_port->Index == 0) {
+                    mstp_port->FrameType = data;
+                } else if (mstp_port->Index == 1) {
+                    mstp_port->DestinationAddress = data;
+                } else if (mstp_port->Index == 2) {
+                    mstp_port->SourceAddress = data;
+                } else if (mstp_port->Index == 3) {
+                    mstp_port->DataLength = data * 256;
+                } else {
+                    mstp_port->DataLength += data;
+                }
+                mstp_port->Index++;
+                offset++;
+                count++;
+            }
+            MSTP_Event_Count_Add(mstp_port, count);
+            mstp_port->SilenceTimerReset((void *)mstp_port);
+            continue;
+        } else if (
+            ((mstp_port->receive_state == MSTP_RECEIVE_STATE_DATA) ||
+             (mstp_port->receive_state == MSTP_RECEIVE_STATE_SKIP_DATA)) &&
+            (mstp_port->Index < mstp_port->DataLength) &&
+            (mstp_port->SilenceTimer((void *)mstp_port) <=
+             mstp_port->Tframe_abort)) {
+            /* DataOctet for each octet of the data.
+               The data CRC octets are left for the state machine. */
+            count = mstp_port->DataLength - mstp_port->Index;
+            if (count > (length - offset)) {
+                count = length - offset;
+            }
+            if (mstp_port->Index < mstp_port->InputBufferSize) {
+                copy_count = mstp_port->InputBufferSize - mstp_port->Index;
+                if (copy_count > count) {
+                    copy_count = count;
+                }
+                memcpy(
+                    &mstp_port->InputBuffer[mstp_port->Index],
+                    &buffer[offset], copy_count);
+            }
+            mstp_port->DataCRC = CRC_Calc_Data_Buffer(
+                &buffer[offset], count, mstp_port->DataCRC);
+            mstp_port->Index += count;
+            offset += count;
+            mstp_port->SilenceTimerReset((void *)mstp_port);
+            continue;
+        }
+        mstp_port->DataRegister = buffer[offset];
+        mstp_port->DataAvailable = true;
+        MSTP_Receive_Frame_FSM(mstp_port);
+        if (mstp_port->DataAvailable) {
+            /* a timeout was handled - the octet is received again */
+            mstp_port->DataAvailable = false;
+        } else {
+            offset++;
+        }
+    }
+
+    return offset;
+}
+
 /**
  * @brief Finite State Machine for receiving an MSTP frame
  * @param mstp_port MSTP port context data
@@ -254,6 +254,9 @@ void MSTP_Init(struct mstp_port_struct_t *mstp_port);
 BACNET_STACK_EXPORT
 void MSTP_Receive_Frame_FSM(struct mstp_port_struct_t *mstp_port);
 BACNET_STACK_EXPORT
+size_t MSTP_Receive_Frame_Buffer(
+    struct mstp_port_struct_t *mstp_port, const uint8_t *buffer, size_t length);
+BACNET_STACK_EXPORT
 bool MSTP_Master_Node_FSM(struct mstp_port_struct_t *mstp_port);
 BACNET_STACK_EXPORT
 void MSTP_Slave_Node_FSM(struct mstp_port_struct_t *mstp_port);
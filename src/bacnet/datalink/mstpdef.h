@@ -167,6 +167,19 @@ typedef enum MSTP_Auto_Baud_State {
 #define DEFAULT_MAX_MASTER 127
 #define DEFAULT_MAC_ADDRESS 127
 
+/* container for packet and token statistics */
+typedef struct dlmstp_statistics {
+    uint32_t transmit_frame_counter;
+    uint32_t receive_valid_frame_counter;
+    uint32_t receive_invalid_frame_counter;
+    uint32_t receive_valid_frame_not_for_us_counter;
+    uint32_t transmit_pdu_counter;
+    uint32_t receive_pdu_counter;
+    uint32_t lost_token_counter;
+    uint32_t bad_crc_counter;
+    uint32_t poll_for_master_counter;
+} DLMSTP_STATISTICS;
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
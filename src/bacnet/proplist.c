@@ -6,6 +6,7 @@
  * @copyright SPDX-License-Identifier: GPL-2.0-or-later WITH GCC-exception-2.0
  */
 #include <stdint.h>
+#include <string.h>
 /* BACnet Stack defines - first */
 #include "bacnet/bacdef.h"
 /* BACnet Stack API */
@@ -89,6 +90,113 @@ bool property_lists_member(
     return found;
 }
 
+/**
+ * @brief Add the members of a property list to the index bitset
+ * @param index - property list index
+ * @param pList - array of type 'int32_t' that is a list of BACnet
+ * properties, terminated by a '-1' value.
+ * @return number of properties in the list
+ */
+static uint32_t property_list_index_add(
+    struct property_list_index_t *index, const int32_t *pList)
+{
+    uint32_t count = 0;
+    int32_t property;
+
+    if (pList) {
+        while ((property = pList[count]) != -1) {
+            if ((property >= 0) && (property < PROPERTY_LIST_INDEX_BITS)) {
+                index->Members[property / 8] |= (uint8_t)(1 << (property % 8));
+            } else {
+                index->Extended = true;
+            }
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Initialize a property list index with the lists of an object,
+ * counting the lists and recording their members in the bitset.
+ * @param index - property list index to initialize
+ * @param pRequired - array of type 'int32_t' that is a list of BACnet
+ * properties, or NULL
+ * @param pOptional - array of type 'int32_t' that is a list of BACnet
+ * properties, or NULL
+ * @param pProprietary - array of type 'int32_t' that is a list of BACnet
+ * properties, or NULL
+ */
+void property_list_index_init(
+    struct property_list_index_t *index,
+    const int32_t *pRequired,
+    const int32_t *pOptional,
+    const int32_t *pProprietary)
+{
+    if (!index) {
+        return;
+    }
+    memset(index, 0, sizeof(struct property_list_index_t));
+    index->Lists.Required.pList = pRequired;
+    index->Lists.Required.count = property_list_index_add(index, pRequired);
+    index->Lists.Optional.pList = pOptional;
+    index->Lists.Optional.count = property_list_index_add(index, pOptional);
+    index->Lists.Proprietary.pList = pProprietary;
+    index->Lists.Proprietary.count =
+        property_list_index_add(index, pProprietary);
+}
+
+/**
+ * @brief Determine if a property list index was made from these lists
+ * @param index - property list index
+ * @param pRequired - list of required properties, or NULL
+ * @param pOptional - list of optional properties, or NULL
+ * @param pProprietary - list of proprietary properties, or NULL
+ * @return true if the index was initialized with the same lists
+ */
+bool property_list_index_same(
+    const struct property_list_index_t *index,
+    const int32_t *pRequired,
+    const int32_t *pOptional,
+    const int32_t *pProprietary)
+{
+    if (!index) {
+        return false;
+    }
+
+    return (index->Lists.Required.pList == pRequired) &&
+        (index->Lists.Optional.pList == pOptional) &&
+        (index->Lists.Proprietary.pList == pProprietary);
+}
+
+/**
+ * @brief Determine if the object property is a member of any of the lists
+ * of the property list index
+ * @param index - property list index
+ * @param object_property - object-property to be checked
+ * @return true if the property is a member of any of the lists
+ */
+bool property_list_index_member(
+    const struct property_list_index_t *index, int32_t object_property)
+{
+    if (!index) {
+        return false;
+    }
+    if ((object_property >= 0) &&
+        (object_property < PROPERTY_LIST_INDEX_BITS)) {
+        return (index->Members[object_property / 8] &
+                (1 << (object_property % 8))) != 0;
+    }
+    if (!index->Extended) {
+        return false;
+    }
+
+    return property_lists_member(
+        index->Lists.Required.pList, index->Lists.Optional.pList,
+        index->Lists.Proprietary.pList, object_property);
+}
+
 /**
  * ReadProperty handler for this property.  For the given ReadProperty
  * data, the application_data is loaded or the error flags are set.
@@ -133,8 +241,7 @@ int property_list_encode(
             count -= 1;
         }
     }
-    if ((rpdata == NULL) || (rpdata->application_data == NULL) ||
-        (rpdata->application_data_len == 0)) {
+    if ((rpdata == NULL) || (rpdata->application_data_len == 0)) {
         return 0;
     }
     apdu = rpdata->application_data;
@@ -157,10 +264,15 @@ int property_list_encode(
                             continue;
                         } else {
                             len = encode_application_enumerated(
-                                &apdu[apdu_len], (uint32_t)pListRequired[i]);
+                                NULL, (uint32_t)pListRequired[i]);
                         }
                         /* add it if we have room */
                         if ((apdu_len + len) < max_apdu_len) {
+                            if (apdu) {
+                                encode_application_enumerated(
+                                    &apdu[apdu_len],
+                                    (uint32_t)pListRequired[i]);
+                            }
                             apdu_len += len;
                         } else {
                             rpdata->error_code =
@@ -173,9 +285,14 @@ int property_list_encode(
                 if (optional_count) {
                     for (i = 0; i < optional_count; i++) {
                         len = encode_application_enumerated(
-                            &apdu[apdu_len], (uint32_t)pListOptional[i]);
+                            NULL, (uint32_t)pListOptional[i]);
                         /* add it if we have room */
                         if ((apdu_len + len) < max_apdu_len) {
+                            if (apdu) {
+                                encode_application_enumerated(
+                                    &apdu[apdu_len],
+                                    (uint32_t)pListOptional[i]);
+                            }
                             apdu_len += len;
                         } else {
                             rpdata->error_code =
@@ -188,9 +305,14 @@ int property_list_encode(
                 if (proprietary_count) {
                     for (i = 0; i < proprietary_count; i++) {
                         len = encode_application_enumerated(
-                            &apdu[apdu_len], (uint32_t)pListProprietary[i]);
+                            NULL, (uint32_t)pListProprietary[i]);
                         /* add it if we have room */
                         if ((apdu_len + len) < max_apdu_len) {
+                            if (apdu) {
+                                encode_application_enumerated(
+                                    &apdu[apdu_len],
+                                    (uint32_t)pListProprietary[i]);
+                            }
                             apdu_len += len;
                         } else {
                             rpdata->error_code =
@@ -215,7 +337,7 @@ int property_list_encode(
                             }
                             if (count == rpdata->array_index) {
                                 apdu_len = encode_application_enumerated(
-                                    &apdu[apdu_len],
+                                    &apdu[0],
                                     (uint32_t)pListRequired[i]);
                                 break;
                             }
@@ -226,7 +348,7 @@ int property_list_encode(
                             count++;
                             if (count == rpdata->array_index) {
                                 apdu_len = encode_application_enumerated(
-                                    &apdu[apdu_len],
+                                    &apdu[0],
                                     (uint32_t)pListOptional[i]);
                                 break;
                             }
@@ -237,7 +359,7 @@ int property_list_encode(
                             count++;
                             if (count == rpdata->array_index) {
                                 apdu_len = encode_application_enumerated(
-                                    &apdu[apdu_len],
+                                    &apdu[0],
                                     (uint32_t)pListProprietary[i]);
                                 break;
                             }
@@ -280,8 +402,7 @@ int property_list_common_encode(
     if (!rpdata) {
         return 0;
     }
-    if ((rpdata->application_data == NULL) ||
-        (rpdata->application_data_len == 0)) {
+    if (rpdata->application_data_len == 0) {
         return 0;
     }
     apdu = rpdata->application_data;
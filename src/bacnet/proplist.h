@@ -26,6 +26,24 @@ struct special_property_list_t {
     struct property_list_t Proprietary;
 };
 
+/* properties below this value are kept in the membership bitset;
+   any others are found by searching the lists */
+#ifndef PROPERTY_LIST_INDEX_BITS
+#define PROPERTY_LIST_INDEX_BITS (PROP_RESERVED_RANGE_MAX + 1)
+#endif
+
+/**
+ * @brief Property lists of an object type with their counts, and a
+ * bitset of their members, so that checking for a member does not
+ * search the lists.  The lists are expected to be constant arrays.
+ */
+struct property_list_index_t {
+    struct special_property_list_t Lists;
+    uint8_t Members[(PROPERTY_LIST_INDEX_BITS + 7) / 8];
+    /* true if any member is not in the bitset */
+    bool Extended;
+};
+
 /**
  * @brief Callback function type for fetching a property list for a given
  * object instance.
@@ -59,6 +77,21 @@ bool property_lists_member(
     const int32_t *pProprietary,
     int32_t object_property);
 BACNET_STACK_EXPORT
+void property_list_index_init(
+    struct property_list_index_t *index,
+    const int32_t *pRequired,
+    const int32_t *pOptional,
+    const int32_t *pProprietary);
+BACNET_STACK_EXPORT
+bool property_list_index_same(
+    const struct property_list_index_t *index,
+    const int32_t *pRequired,
+    const int32_t *pOptional,
+    const int32_t *pProprietary);
+BACNET_STACK_EXPORT
+bool property_list_index_member(
+    const struct property_list_index_t *index, int32_t object_property);
+BACNET_STACK_EXPORT
 int property_list_encode(
     BACNET_READ_PROPERTY_DATA *rpdata,
     const int32_t *pListRequired,
@@ -32,6 +32,11 @@ struct BACnet_Read_Access_Data;
  * A function template; @see device.c for assignment to object types.
  * @ingroup ObjHelpers
  *
+ * A function that supports the size query mode returns the length that
+ * would be encoded, without writing anything, when application_data is
+ * NULL; application_data_len still limits the length. Functions that
+ * do not support it return zero for a NULL application_data.
+ *
  * @param rp_data [in] Pointer to the BACnet_Read_Property_Data structure,
  *                     which is packed with the information from the RP request.
  * @return The length of the apdu encoded or -1 for error or
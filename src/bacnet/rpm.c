@@ -542,6 +542,104 @@ int rpm_ack_encode_apdu_object_end(uint8_t *apdu)
 }
 
 #if BACNET_SVC_RPM_A
+/**
+ * @brief Read the ReadPropertyMultiple-Ack object-identifier and the
+ *  opening tag of its list-of-results
+ * @param reader - reader positioned at the object-identifier
+ * @param object_type [out] The object type of the object identifier.
+ * @param object_instance [out] The object instance of the object identifier.
+ * @return true if the object-identifier and opening tag were read
+ */
+bool rpm_ack_read_object_id(
+    BACNET_READER *reader,
+    BACNET_OBJECT_TYPE *object_type,
+    uint32_t *object_instance)
+{
+    /* Tag 0: objectIdentifier */
+    if (!bacnet_reader_context_object_id(
+            reader, 0, object_type, object_instance)) {
+        return false;
+    }
+    /* Tag 1: listOfResults */
+    return bacnet_reader_opening(reader, 1);
+}
+
+/**
+ * @brief Read the ReadPropertyMultiple-Ack property-identifier and the
+ *  optional property-array-index
+ * @param reader - reader positioned at the property-identifier
+ * @param object_property [out] The object property of the object identifier.
+ * @param array_index [out] The array index of the object property.
+ * @return true if the property reference was read
+ */
+bool rpm_ack_read_object_property(
+    BACNET_READER *reader,
+    BACNET_PROPERTY_ID *object_property,
+    BACNET_ARRAY_INDEX *array_index)
+{
+    BACNET_UNSIGNED_INTEGER unsigned_value = 0; /* for decoding */
+    uint32_t enum_value = 0; /* for decoding */
+
+    /* Tag 2: propertyIdentifier */
+    if (!bacnet_reader_context_enumerated(reader, 2, &enum_value)) {
+        return false;
+    }
+    if (object_property) {
+        *object_property = (BACNET_PROPERTY_ID)enum_value;
+    }
+    /* Tag 3: Optional propertyArrayIndex */
+    if (bacnet_reader_context_unsigned(reader, 3, &unsigned_value)) {
+        if (unsigned_value >= UINT32_MAX) {
+            return false;
+        }
+        if (array_index) {
+            *array_index = (BACNET_ARRAY_INDEX)unsigned_value;
+        }
+    } else if (bacnet_reader_error(reader)) {
+        return false;
+    } else {
+        /* optional - assume ALL array elements */
+        if (array_index) {
+            *array_index = BACNET_ARRAY_ALL;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Read the ReadPropertyMultiple-Ack property-access-error
+ * @param reader - reader positioned at the opening tag [5]
+ * @param error_class [out] The error class of the property access error.
+ * @param error_code [out] The error code of the property access error.
+ * @return true if the property-access-error was read
+ */
+bool rpm_ack_read_access_error(
+    BACNET_READER *reader,
+    BACNET_ERROR_CLASS *error_class,
+    BACNET_ERROR_CODE *error_code)
+{
+    uint32_t error_value = 0; /* decoded error value */
+
+    if (!bacnet_reader_opening(reader, 5)) {
+        return false;
+    }
+    if (!bacnet_reader_application_enumerated(reader, &error_value)) {
+        return false;
+    }
+    if (error_class) {
+        *error_class = (BACNET_ERROR_CLASS)error_value;
+    }
+    if (!bacnet_reader_application_enumerated(reader, &error_value)) {
+        return false;
+    }
+    if (error_code) {
+        *error_code = (BACNET_ERROR_CODE)error_value;
+    }
+
+    return bacnet_reader_closing(reader, 5);
+}
+
 /**
  * @brief Decode the ReadPropertyMultiple-Ack object-identifier
  * @param apdu application data unit buffer for decoding
@@ -556,28 +654,18 @@ int rpm_ack_decode_object_id(
     BACNET_OBJECT_TYPE *object_type,
     uint32_t *object_instance)
 {
-    int apdu_len = 0, len = 0;
+    BACNET_READER reader = { 0 };
 
     /* check for valid buffer and length */
-    if (apdu && apdu_size) {
-        /* Tag 0: objectIdentifier */
-        len = bacnet_object_id_context_decode(
-            &apdu[apdu_len], apdu_size - apdu_len, 0, object_type,
-            object_instance);
-        if (len <= 0) {
-            return BACNET_STATUS_ERROR;
-        }
-        apdu_len += len;
-        /* Tag 1: listOfResults */
-        len = bacnet_is_opening_tag_number(
-            &apdu[apdu_len], apdu_size - apdu_len, 1, &len);
-        if (len <= 0) {
-            return BACNET_STATUS_ERROR;
-        }
-        apdu_len += len;
+    if (!apdu || !apdu_size) {
+        return 0;
+    }
+    bacnet_reader_init(&reader, apdu, apdu_size);
+    if (!rpm_ack_read_object_id(&reader, object_type, object_instance)) {
+        return BACNET_STATUS_ERROR;
     }
 
-    return apdu_len;
+    return (int)bacnet_reader_offset(&reader);
 }
 
 /**
@@ -614,10 +702,7 @@ int rpm_ack_decode_object_property(
     BACNET_PROPERTY_ID *object_property,
     BACNET_ARRAY_INDEX *array_index)
 {
-    int len = 0;
-    int apdu_len = 0;
-    BACNET_UNSIGNED_INTEGER unsigned_value = 0; /* for decoding */
-    uint32_t enum_value = 0; /* for decoding */
+    BACNET_READER reader = { 0 };
 
     /* check for valid pointers */
     if (!apdu) {
@@ -626,37 +711,30 @@ int rpm_ack_decode_object_property(
     if (apdu_size == 0) {
         return BACNET_STATUS_ERROR;
     }
-    /* Tag 2: propertyIdentifier */
-    len = bacnet_enumerated_context_decode(
-        &apdu[apdu_len], apdu_size - apdu_len, 2, &enum_value);
-    if (len > 0) {
-        apdu_len += len;
-        if (object_property) {
-            *object_property = (BACNET_PROPERTY_ID)enum_value;
-        }
-    } else {
+    bacnet_reader_init(&reader, apdu, apdu_size);
+    if (!rpm_ack_read_object_property(&reader, object_property, array_index)) {
         return BACNET_STATUS_ERROR;
     }
-    /* Tag 3: Optional propertyArrayIndex */
-    len = bacnet_unsigned_context_decode(
-        &apdu[apdu_len], apdu_size - apdu_len, 3, &unsigned_value);
-    if (len > 0) {
-        apdu_len += len;
-        if (unsigned_value < UINT32_MAX) {
-            if (array_index) {
-                *array_index = (BACNET_ARRAY_INDEX)unsigned_value;
-            }
-        } else {
-            return BACNET_STATUS_ERROR;
-        }
-    } else {
-        /* optional - assume ALL array elements */
-        if (array_index) {
-            *array_index = BACNET_ARRAY_ALL;
-        }
-    }
 
-    return apdu_len;
+    return (int)bacnet_reader_offset(&reader);
+}
+
+/**
+ * @brief Report a malformed RPM Ack to the ReadProperty-ACK function
+ * @param device_id [in] The device ID of the device that replied.
+ * @param rp_data [in] The data structure to be filled.
+ * @param callback [in] The function to call for each property value.
+ */
+static void rpm_ack_object_property_malformed(
+    uint32_t device_id,
+    BACNET_READ_PROPERTY_DATA *rp_data,
+    read_property_ack_process callback)
+{
+    rp_data->error_class = ERROR_CLASS_SERVICES;
+    rp_data->error_code = ERROR_CODE_INVALID_TAG;
+    if (callback) {
+        callback(device_id, rp_data);
+    }
 }
 
 /**
@@ -678,6 +756,9 @@ int rpm_ack_decode_object_property(
  *      }
  *  }
  *
+ * The property values are handed to the callback in place, and each
+ * one is walked only once to find its end.
+ *
  * @param apdu [in] Buffer of bytes received.
  * @param apdu_len [in] Count of valid bytes in the buffer.
  * @param device_id [in] The device ID of the device that replied.
@@ -691,9 +772,9 @@ void rpm_ack_object_property_process(
     BACNET_READ_PROPERTY_DATA *rp_data,
     read_property_ack_process callback)
 {
-    int len = 0;
-    int application_data_len;
-    uint32_t error_value = 0; /* decoded error value */
+    BACNET_READER reader = { 0 };
+    const uint8_t *application_data = NULL;
+    uint32_t application_data_len = 0;
 
     if (!apdu) {
         return;
@@ -701,129 +782,48 @@ void rpm_ack_object_property_process(
     if (!rp_data) {
         return;
     }
-    while (apdu_len) {
+    bacnet_reader_init(&reader, apdu, apdu_len);
+    while (bacnet_reader_remaining(&reader)) {
         /*  object-identifier [0] BACnetObjectIdentifier */
         /*  list-of-results [1] SEQUENCE OF SEQUENCE */
-        len = rpm_ack_decode_object_id(
-            apdu, apdu_len, &rp_data->object_type, &rp_data->object_instance);
-        if (len <= 0) {
-            /* malformed */
-            rp_data->error_class = ERROR_CLASS_SERVICES;
-            rp_data->error_code = ERROR_CODE_INVALID_TAG;
-            if (callback) {
-                callback(device_id, rp_data);
-            }
+        if (!rpm_ack_read_object_id(
+                &reader, &rp_data->object_type, &rp_data->object_instance)) {
+            rpm_ack_object_property_malformed(device_id, rp_data, callback);
             return;
         }
-        apdu_len -= len;
-        apdu += len;
-        while (apdu_len) {
-            if (bacnet_is_closing_tag_number(apdu, apdu_len, 1, &len)) {
+        while (bacnet_reader_remaining(&reader)) {
+            if (bacnet_reader_closing(&reader, 1)) {
                 /*  end of list-of-results [1] SEQUENCE OF SEQUENCE */
-                apdu_len -= len;
-                apdu += len;
                 break;
             }
-            len = rpm_ack_decode_object_property(
-                apdu, apdu_len, &rp_data->object_property,
-                &rp_data->array_index);
-            if (len <= 0) {
-                /* malformed */
-                rp_data->error_class = ERROR_CLASS_SERVICES;
-                rp_data->error_code = ERROR_CODE_INVALID_TAG;
-                if (callback) {
-                    callback(device_id, rp_data);
-                }
+            if (!rpm_ack_read_object_property(
+                    &reader, &rp_data->object_property,
+                    &rp_data->array_index)) {
+                rpm_ack_object_property_malformed(
+                    device_id, rp_data, callback);
                 return;
             }
-            apdu_len -= len;
-            apdu += len;
-            if (bacnet_is_opening_tag_number(apdu, apdu_len, 4, &len)) {
-                application_data_len =
-                    bacnet_enclosed_data_length(apdu, apdu_len);
-                if (application_data_len < 0) {
-                    /* malformed */
-                    rp_data->error_class = ERROR_CLASS_SERVICES;
-                    rp_data->error_code = ERROR_CODE_INVALID_TAG;
-                    if (callback) {
-                        callback(device_id, rp_data);
-                    }
-                    return;
-                }
-                /* propertyValue */
-                apdu_len -= len;
-                apdu += len;
-                /* fill the RP application data */
-                rp_data->application_data_len = application_data_len;
-                rp_data->application_data = apdu;
-                apdu_len -= application_data_len;
-                apdu += application_data_len;
-                if (bacnet_is_closing_tag_number(apdu, apdu_len, 4, &len)) {
-                    apdu_len -= len;
-                    apdu += len;
-                } else {
-                    /* malformed */
-                    rp_data->error_class = ERROR_CLASS_SERVICES;
-                    rp_data->error_code = ERROR_CODE_INVALID_TAG;
-                    if (callback) {
-                        callback(device_id, rp_data);
-                    }
-                    return;
-                }
+            if (bacnet_reader_enclosed(
+                    &reader, 4, &application_data, &application_data_len)) {
+                /* propertyValue: fill the RP application data */
+                rp_data->application_data_len = (int)application_data_len;
+                rp_data->application_data = &apdu[application_data - apdu];
                 rp_data->error_class = ERROR_CLASS_PROPERTY;
                 rp_data->error_code = ERROR_CODE_SUCCESS;
                 if (callback) {
                     callback(device_id, rp_data);
                 }
-            } else if (bacnet_is_opening_tag_number(apdu, apdu_len, 5, &len)) {
-                apdu_len -= len;
-                apdu += len;
+            } else if (rpm_ack_read_access_error(
+                           &reader, &rp_data->error_class,
+                           &rp_data->error_code)) {
                 /* property-access-error */
-                len = bacnet_enumerated_application_decode(
-                    apdu, apdu_len, &error_value);
-                if (len > 0) {
-                    rp_data->error_class = (BACNET_ERROR_CLASS)error_value;
-                    apdu_len -= len;
-                    apdu += len;
-                } else {
-                    /* malformed */
-                    rp_data->error_class = ERROR_CLASS_SERVICES;
-                    rp_data->error_code = ERROR_CODE_INVALID_TAG;
-                    if (callback) {
-                        callback(device_id, rp_data);
-                    }
-                    return;
-                }
-                len = bacnet_enumerated_application_decode(
-                    apdu, apdu_len, &error_value);
-                if (len > 0) {
-                    rp_data->error_code = (BACNET_ERROR_CODE)error_value;
-                    apdu_len -= len;
-                    apdu += len;
-                } else {
-                    /* malformed */
-                    rp_data->error_class = ERROR_CLASS_SERVICES;
-                    rp_data->error_code = ERROR_CODE_INVALID_TAG;
-                    if (callback) {
-                        callback(device_id, rp_data);
-                    }
-                    return;
-                }
-                if (bacnet_is_closing_tag_number(apdu, apdu_len, 5, &len)) {
-                    apdu_len -= len;
-                    apdu += len;
-                } else {
-                    /* malformed */
-                    rp_data->error_class = ERROR_CLASS_SERVICES;
-                    rp_data->error_code = ERROR_CODE_INVALID_TAG;
-                    if (callback) {
-                        callback(device_id, rp_data);
-                    }
-                    return;
-                }
                 if (callback) {
                     callback(device_id, rp_data);
                 }
+            } else {
+                rpm_ack_object_property_malformed(
+                    device_id, rp_data, callback);
+                return;
             }
         }
     }
@@ -15,6 +15,7 @@
 #include "bacnet/bacdef.h"
 /* BACnet Stack API */
 #include "bacnet/bacapp.h"
+#include "bacnet/bacdcode.h"
 #include "bacnet/proplist.h"
 #include "bacnet/rp.h"
 /*
@@ -161,6 +162,21 @@ int rpm_ack_decode_object_property(
     BACNET_PROPERTY_ID *object_property,
     BACNET_ARRAY_INDEX *array_index);
 BACNET_STACK_EXPORT
+bool rpm_ack_read_object_id(
+    BACNET_READER *reader,
+    BACNET_OBJECT_TYPE *object_type,
+    uint32_t *object_instance);
+BACNET_STACK_EXPORT
+bool rpm_ack_read_object_property(
+    BACNET_READER *reader,
+    BACNET_PROPERTY_ID *object_property,
+    BACNET_ARRAY_INDEX *array_index);
+BACNET_STACK_EXPORT
+bool rpm_ack_read_access_error(
+    BACNET_READER *reader,
+    BACNET_ERROR_CLASS *error_class,
+    BACNET_ERROR_CODE *error_code);
+BACNET_STACK_EXPORT
 void rpm_ack_object_property_process(
     uint8_t *apdu,
     unsigned apdu_len,
@@ -0,0 +1,307 @@
+/**
+ * @file
+ * @brief BACnet compact application value API testing
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2026
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <bacnet/bacdcode.h>
+#include <bacnet/bacapp.h>
+#include <bacnet/bacapp_compact.h>
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+static const struct {
+    BACNET_APPLICATION_TAG tag;
+    const char *argv;
+} Primitive_Values[] = {
+    { BACNET_APPLICATION_TAG_NULL, "" },
+    { BACNET_APPLICATION_TAG_BOOLEAN, "1" },
+    { BACNET_APPLICATION_TAG_UNSIGNED_INT, "4194303" },
+    { BACNET_APPLICATION_TAG_SIGNED_INT, "-1234567" },
+    { BACNET_APPLICATION_TAG_REAL, "3.14159" },
+    { BACNET_APPLICATION_TAG_DOUBLE, "-2.718281828" },
+    { BACNET_APPLICATION_TAG_OCTET_STRING, "0123456789ABCDEF" },
+    { BACNET_APPLICATION_TAG_CHARACTER_STRING, "Hello, compact world" },
+    { BACNET_APPLICATION_TAG_BIT_STRING, "1011001110" },
+    { BACNET_APPLICATION_TAG_ENUMERATED, "62" },
+    { BACNET_APPLICATION_TAG_DATE, "2026/10/18:7" },
+    { BACNET_APPLICATION_TAG_TIME, "23:59:58.99" },
+    { BACNET_APPLICATION_TAG_OBJECT_ID, "8:4194302" },
+};
+
+/**
+ * @brief Test that every primitive value survives a compact round trip
+ *  and that variable length data references the APDU
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bacapp_compact_tests, test_bacapp_compact_primitive)
+#else
+static void test_bacapp_compact_primitive(void)
+#endif
+{
+    BACNET_APPLICATION_DATA_VALUE value = { 0 }, test_value = { 0 };
+    BACNET_COMPACT_VALUE compact = { 0 };
+    uint8_t apdu[MAX_APDU] = { 0 }, test_apdu[MAX_APDU] = { 0 };
+    int apdu_len, len, test_len;
+    unsigned i;
+    bool status;
+
+    zassert_true(sizeof(BACNET_COMPACT_VALUE) <= 16, NULL);
+    for (i = 0; i < ARRAY_SIZE(Primitive_Values); i++) {
+        status = bacapp_parse_application_data(
+            Primitive_Values[i].tag, Primitive_Values[i].argv, &value);
+        zassert_true(status, "tag=%u", Primitive_Values[i].tag);
+        apdu_len = bacapp_encode_application_data(apdu, &value);
+        zassert_true(apdu_len > 0, NULL);
+        len = bacapp_compact_decode(apdu, apdu_len, &compact);
+        zassert_equal(len, apdu_len, "tag=%u", Primitive_Values[i].tag);
+        zassert_equal(compact.tag, Primitive_Values[i].tag, NULL);
+        zassert_false(compact.context_specific, NULL);
+        if (compact.length > 0) {
+            /* zero copy: the data is still in the APDU */
+            zassert_true(compact.type.Data > apdu, NULL);
+            zassert_true(compact.type.Data < &apdu[apdu_len], NULL);
+        }
+        test_len = bacapp_compact_encode(NULL, &compact);
+        zassert_equal(test_len, apdu_len, NULL);
+        test_len = bacapp_compact_encode(test_apdu, &compact);
+        zassert_equal(test_len, apdu_len, NULL);
+        zassert_equal(memcmp(apdu, test_apdu, apdu_len), 0, NULL);
+        status = bacapp_compact_to_value(
+            &compact, &test_value, OBJECT_ANALOG_VALUE, PROP_PRESENT_VALUE);
+        zassert_true(status, "tag=%u", Primitive_Values[i].tag);
+        zassert_true(bacapp_same_value(&value, &test_value), NULL);
+        /* truncated APDU */
+        if (apdu_len > 1) {
+            len = bacapp_compact_decode(apdu, apdu_len - 1, &compact);
+            zassert_equal(len, BACNET_STATUS_ERROR, "tag=%u", compact.tag);
+        }
+    }
+    len = bacapp_compact_decode(NULL, sizeof(apdu), &compact);
+    zassert_equal(len, BACNET_STATUS_ERROR, NULL);
+    len = bacapp_compact_decode(apdu, 0, &compact);
+    zassert_equal(len, BACNET_STATUS_ERROR, NULL);
+    len = bacapp_compact_decode(apdu, sizeof(apdu), NULL);
+    zassert_equal(len, BACNET_STATUS_ERROR, NULL);
+}
+
+/**
+ * @brief Test context tagged, constructed, and complex property values
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bacapp_compact_tests, test_bacapp_compact_constructed)
+#else
+static void test_bacapp_compact_constructed(void)
+#endif
+{
+    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+    BACNET_COMPACT_VALUE compact = { 0 }, test_compact = { 0 };
+    BACNET_DATE_RANGE range = { 0 };
+    uint8_t apdu[MAX_APDU] = { 0 }, test_apdu[MAX_APDU] = { 0 };
+    int apdu_len, len;
+    bool status;
+
+    /* context tagged primitive */
+    apdu_len = encode_context_unsigned(apdu, 3, 1234);
+    len = bacapp_compact_decode(apdu, apdu_len, &compact);
+    zassert_equal(len, apdu_len, NULL);
+    zassert_equal(compact.tag, BACNET_APPLICATION_TAG_ABSTRACT_SYNTAX, NULL);
+    zassert_true(compact.context_specific, NULL);
+    zassert_equal(compact.context_tag, 3, NULL);
+    zassert_equal(compact.length, apdu_len, NULL);
+    zassert_true(compact.type.Data == apdu, NULL);
+    /* constructed value keeps both tags */
+    apdu_len = encode_opening_tag(apdu, 2);
+    apdu_len += encode_application_real(&apdu[apdu_len], 1.0f);
+    apdu_len += encode_opening_tag(&apdu[apdu_len], 2);
+    apdu_len += encode_application_unsigned(&apdu[apdu_len], 5);
+    apdu_len += encode_closing_tag(&apdu[apdu_len], 2);
+    apdu_len += encode_closing_tag(&apdu[apdu_len], 2);
+    len = encode_application_null(&apdu[apdu_len]);
+    len = bacapp_compact_decode(apdu, apdu_len + len, &compact);
+    zassert_equal(len, apdu_len, NULL);
+    zassert_equal(compact.length, apdu_len, NULL);
+    len = bacapp_compact_encode(test_apdu, &compact);
+    zassert_equal(len, apdu_len, NULL);
+    zassert_equal(memcmp(apdu, test_apdu, apdu_len), 0, NULL);
+    status = bacapp_compact_to_value(
+        &compact, &value, OBJECT_ANALOG_VALUE, PROP_PRESENT_VALUE);
+    zassert_false(status, NULL);
+    /* missing closing tag */
+    len = bacapp_compact_decode(apdu, apdu_len - 1, &compact);
+    zassert_equal(len, BACNET_STATUS_ERROR, NULL);
+    /* complex property datatype */
+    range.startdate.year = 2026;
+    range.startdate.month = 1;
+    range.startdate.day = 1;
+    range.startdate.wday = 4;
+    range.enddate.year = 2026;
+    range.enddate.month = 12;
+    range.enddate.day = 31;
+    range.enddate.wday = 4;
+    apdu_len = bacnet_daterange_encode(apdu, &range);
+    len = bacapp_compact_decode_known_property(
+        apdu, sizeof(apdu), &compact, OBJECT_SCHEDULE, PROP_EFFECTIVE_PERIOD);
+    zassert_equal(len, apdu_len, NULL);
+    zassert_equal(compact.tag, BACNET_APPLICATION_TAG_DATERANGE, NULL);
+    zassert_equal(compact.length, apdu_len, NULL);
+    status = bacapp_compact_to_value(
+        &compact, &value, OBJECT_SCHEDULE, PROP_EFFECTIVE_PERIOD);
+    zassert_true(status, NULL);
+    zassert_equal(value.tag, BACNET_APPLICATION_TAG_DATERANGE, NULL);
+    zassert_equal(value.type.Date_Range.enddate.month, 12, NULL);
+    /* primitive property datatype */
+    apdu_len = encode_application_real(apdu, 42.0f);
+    len = bacapp_compact_decode_known_property(
+        apdu, apdu_len, &test_compact, OBJECT_ANALOG_VALUE,
+        PROP_PRESENT_VALUE);
+    zassert_equal(len, apdu_len, NULL);
+    zassert_equal(test_compact.tag, BACNET_APPLICATION_TAG_REAL, NULL);
+    zassert_false(bacapp_compact_same(&compact, &test_compact), NULL);
+}
+
+/**
+ * @brief Test that values moved into an arena no longer need the APDU
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bacapp_compact_tests, test_bacapp_compact_arena)
+#else
+static void test_bacapp_compact_arena(void)
+#endif
+{
+    BACNET_APPLICATION_DATA_VALUE value = { 0 }, test_value = { 0 };
+    BACNET_COMPACT_VALUE compact = { 0 }, test_compact = { 0 };
+    BACNET_COMPACT_ARENA arena = { 0 };
+    uint8_t arena_buffer[32] = { 0 };
+    uint8_t apdu[MAX_APDU] = { 0 };
+    int apdu_len, len;
+    bool status;
+
+    bacapp_compact_arena_init(&arena, arena_buffer, sizeof(arena_buffer));
+    zassert_equal(
+        bacapp_compact_arena_free(&arena), sizeof(arena_buffer), NULL);
+    status = bacapp_parse_application_data(
+        BACNET_APPLICATION_TAG_CHARACTER_STRING, "Zone 1 Temp", &value);
+    zassert_true(status, NULL);
+    apdu_len = bacapp_encode_application_data(apdu, &value);
+    len = bacapp_compact_decode(apdu, apdu_len, &compact);
+    zassert_equal(len, apdu_len, NULL);
+    test_compact = compact;
+    status = bacapp_compact_arena_store(&arena, &compact);
+    zassert_true(status, NULL);
+    zassert_true(compact.type.Data == arena_buffer, NULL);
+    zassert_equal(arena.used, strlen("Zone 1 Temp"), NULL);
+    zassert_true(bacapp_compact_same(&compact, &test_compact), NULL);
+    /* the APDU may be reused now */
+    memset(apdu, 0, sizeof(apdu));
+    status = bacapp_compact_to_value(
+        &compact, &test_value, OBJECT_ANALOG_VALUE, PROP_OBJECT_NAME);
+    zassert_true(status, NULL);
+    zassert_true(bacapp_same_value(&value, &test_value), NULL);
+    /* scalars do not use the arena */
+    status = bacapp_parse_application_data(
+        BACNET_APPLICATION_TAG_REAL, "72.5", &value);
+    zassert_true(status, NULL);
+    status = bacapp_compact_from_value(&compact, &value, NULL);
+    zassert_true(status, NULL);
+    zassert_equal(compact.tag, BACNET_APPLICATION_TAG_REAL, NULL);
+    status = bacapp_compact_arena_store(&arena, &compact);
+    zassert_true(status, NULL);
+    zassert_equal(arena.used, strlen("Zone 1 Temp"), NULL);
+    /* strings are encoded into the arena */
+    status = bacapp_parse_application_data(
+        BACNET_APPLICATION_TAG_CHARACTER_STRING, "AHU-1", &value);
+    zassert_true(status, NULL);
+    status = bacapp_compact_from_value(&compact, &value, NULL);
+    zassert_false(status, NULL);
+    status = bacapp_compact_from_value(&compact, &value, &arena);
+    zassert_true(status, NULL);
+    zassert_equal(compact.length, strlen("AHU-1"), NULL);
+    zassert_equal(memcmp(compact.type.Data, "AHU-1", compact.length), 0, NULL);
+    status = bacapp_compact_to_value(
+        &compact, &test_value, OBJECT_ANALOG_VALUE, PROP_OBJECT_NAME);
+    zassert_true(status, NULL);
+    zassert_true(bacapp_same_value(&value, &test_value), NULL);
+    /* full arena */
+    status = bacapp_parse_application_data(
+        BACNET_APPLICATION_TAG_CHARACTER_STRING,
+        "this name does not fit in the arena", &value);
+    zassert_true(status, NULL);
+    status = bacapp_compact_from_value(&compact, &value, &arena);
+    zassert_false(status, NULL);
+    bacapp_compact_arena_reset(&arena);
+    zassert_equal(
+        bacapp_compact_arena_free(&arena), sizeof(arena_buffer), NULL);
+}
+
+/**
+ * @brief Test that compact values print like application values
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bacapp_compact_tests, test_bacapp_compact_snprintf)
+#else
+static void test_bacapp_compact_snprintf(void)
+#endif
+{
+    BACNET_APPLICATION_DATA_VALUE value = { 0 };
+    BACNET_OBJECT_PROPERTY_VALUE object_value = { 0 };
+    BACNET_COMPACT_VALUE compact = { 0 };
+    uint8_t apdu[MAX_APDU] = { 0 };
+    char str[64] = { 0 }, test_str[64] = { 0 };
+    int apdu_len, len, test_len;
+    unsigned i;
+
+    object_value.object_type = OBJECT_ANALOG_VALUE;
+    object_value.object_property = PROP_PRESENT_VALUE;
+    object_value.array_index = BACNET_ARRAY_ALL;
+    object_value.value = &value;
+    for (i = 0; i < ARRAY_SIZE(Primitive_Values); i++) {
+        bacapp_parse_application_data(
+            Primitive_Values[i].tag, Primitive_Values[i].argv, &value);
+        apdu_len = bacapp_encode_application_data(apdu, &value);
+        bacapp_compact_decode(apdu, apdu_len, &compact);
+        len = bacapp_snprintf_value(str, sizeof(str), &object_value);
+        test_len = bacapp_compact_snprintf(
+            test_str, sizeof(test_str), &compact, OBJECT_ANALOG_VALUE,
+            PROP_PRESENT_VALUE);
+        zassert_equal(len, test_len, "tag=%u", Primitive_Values[i].tag);
+        zassert_equal(strcmp(str, test_str), 0, "%s!=%s", str, test_str);
+        test_len = bacapp_compact_snprintf(
+            NULL, 0, &compact, OBJECT_ANALOG_VALUE, PROP_PRESENT_VALUE);
+        zassert_equal(len, test_len, NULL);
+    }
+    /* unknown datatypes print their encoding */
+    apdu_len = encode_context_unsigned(apdu, 1, 0x12);
+    bacapp_compact_decode(apdu, apdu_len, &compact);
+    test_len = bacapp_compact_snprintf(
+        test_str, sizeof(test_str), &compact, OBJECT_ANALOG_VALUE,
+        PROP_PRESENT_VALUE);
+    zassert_equal(strcmp(test_str, "X'1912'"), 0, "%s", test_str);
+    zassert_equal(test_len, strlen("X'1912'"), NULL);
+}
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(bacapp_compact_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(
+        bacapp_compact_tests, ztest_unit_test(test_bacapp_compact_primitive),
+        ztest_unit_test(test_bacapp_compact_constructed),
+        ztest_unit_test(test_bacapp_compact_arena),
+        ztest_unit_test(test_bacapp_compact_snprintf));
+
+    ztest_run_test_suite(bacapp_compact_tests);
+}
+#endif
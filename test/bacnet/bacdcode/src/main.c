@@ -2451,6 +2451,145 @@ static void test_bacnet_enclosed_data_length(void)
     zassert_equal(test_len, BACNET_STATUS_ERROR, "test_len=%d", test_len);
 }
 
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(bacdcode_tests, test_bacnet_reader)
+#else
+static void test_bacnet_reader(void)
+#endif
+{
+    uint8_t apdu[64] = { 0 };
+    int apdu_len = 0, enclosed_start = 0, enclosed_len = 0, test_len = 0;
+    BACNET_READER reader = { 0 };
+    const BACNET_TAG *tag = NULL;
+    const uint8_t *data = NULL;
+    uint32_t data_len = 0;
+    BACNET_UNSIGNED_INTEGER unsigned_value = 0;
+    uint32_t enumerated_value = 0;
+    BACNET_OBJECT_TYPE object_type = OBJECT_NONE;
+    uint32_t object_instance = 0;
+    int32_t signed_value = 0;
+    float real_value = 0.0f;
+    bool boolean_value = false;
+
+    apdu_len += encode_context_object_id(
+        &apdu[apdu_len], 0, OBJECT_ANALOG_INPUT, 1234);
+    apdu_len += encode_context_unsigned(&apdu[apdu_len], 1, 4321);
+    apdu_len += encode_opening_tag(&apdu[apdu_len], 2);
+    enclosed_start = apdu_len;
+    apdu_len += encode_opening_tag(&apdu[apdu_len], 2);
+    apdu_len += encode_application_boolean(&apdu[apdu_len], true);
+    apdu_len += encode_closing_tag(&apdu[apdu_len], 2);
+    apdu_len += encode_application_real(&apdu[apdu_len], 3.5f);
+    enclosed_len = apdu_len - enclosed_start;
+    apdu_len += encode_closing_tag(&apdu[apdu_len], 2);
+    apdu_len += encode_context_enumerated(&apdu[apdu_len], 3, 7);
+    apdu_len += encode_application_boolean(&apdu[apdu_len], true);
+    apdu_len += encode_application_signed(&apdu[apdu_len], -99);
+    apdu_len += encode_application_real(&apdu[apdu_len], 1.5f);
+    apdu_len += encode_application_unsigned(&apdu[apdu_len], 42);
+    apdu_len += encode_application_enumerated(&apdu[apdu_len], 3);
+    apdu_len += encode_application_object_id(
+        &apdu[apdu_len], OBJECT_DEVICE, 5);
+    apdu_len += encode_opening_tag(&apdu[apdu_len], 4);
+    apdu_len += encode_context_unsigned(&apdu[apdu_len], 0, 1);
+    apdu_len += encode_closing_tag(&apdu[apdu_len], 4);
+    zassert_true(apdu_len < (int)sizeof(apdu), NULL);
+
+    bacnet_reader_init(&reader, apdu, apdu_len);
+    tag = bacnet_reader_peek(&reader);
+    zassert_not_null(tag, NULL);
+    zassert_true(tag->context, NULL);
+    zassert_equal(tag->number, 0, NULL);
+    /* a mismatched tag is left in place without an error */
+    zassert_false(bacnet_reader_context_unsigned(&reader, 1, NULL), NULL);
+    zassert_false(bacnet_reader_application_object_id(&reader, NULL, NULL),
+        NULL);
+    zassert_false(bacnet_reader_error(&reader), NULL);
+    zassert_equal(bacnet_reader_offset(&reader), 0, NULL);
+    zassert_true(
+        bacnet_reader_context_object_id(
+            &reader, 0, &object_type, &object_instance),
+        NULL);
+    zassert_equal(object_type, OBJECT_ANALOG_INPUT, NULL);
+    zassert_equal(object_instance, 1234, NULL);
+    zassert_true(
+        bacnet_reader_context_unsigned(&reader, 1, &unsigned_value), NULL);
+    zassert_equal(unsigned_value, 4321, NULL);
+    /* constructed data is referenced in place */
+    zassert_false(bacnet_reader_is_closing(&reader, 2), NULL);
+    zassert_true(bacnet_reader_is_opening(&reader, 2), NULL);
+    zassert_true(
+        bacnet_reader_enclosed(&reader, 2, &data, &data_len), NULL);
+    zassert_equal(data, &apdu[enclosed_start], NULL);
+    zassert_equal(data_len, enclosed_len, NULL);
+    zassert_equal(
+        bacnet_enclosed_data_length(&apdu[enclosed_start - 1],
+            apdu_len - enclosed_start + 1),
+        enclosed_len, NULL);
+    zassert_true(
+        bacnet_reader_context_enumerated(&reader, 3, &enumerated_value),
+        NULL);
+    zassert_equal(enumerated_value, 7, NULL);
+    zassert_true(
+        bacnet_reader_application_boolean(&reader, &boolean_value), NULL);
+    zassert_true(boolean_value, NULL);
+    zassert_true(
+        bacnet_reader_application_signed(&reader, &signed_value), NULL);
+    zassert_equal(signed_value, -99, NULL);
+    zassert_true(bacnet_reader_application_real(&reader, &real_value), NULL);
+    zassert_false(islessgreater(real_value, 1.5f), NULL);
+    zassert_true(
+        bacnet_reader_application_unsigned(&reader, &unsigned_value), NULL);
+    zassert_equal(unsigned_value, 42, NULL);
+    zassert_true(
+        bacnet_reader_application_enumerated(&reader, &enumerated_value),
+        NULL);
+    zassert_equal(enumerated_value, 3, NULL);
+    zassert_true(
+        bacnet_reader_application_object_id(
+            &reader, &object_type, &object_instance),
+        NULL);
+    zassert_equal(object_type, OBJECT_DEVICE, NULL);
+    zassert_equal(object_instance, 5, NULL);
+    /* skip a constructed value in one pass */
+    test_len = bacnet_reader_skip(&reader);
+    zassert_equal(test_len, 4, "test_len=%d", test_len);
+    zassert_equal(bacnet_reader_remaining(&reader), 0, NULL);
+    zassert_is_null(bacnet_reader_peek(&reader), NULL);
+    zassert_false(bacnet_reader_error(&reader), NULL);
+    zassert_true(bacnet_reader_skip(&reader) < 0, NULL);
+
+    /* a closing tag can not be skipped */
+    bacnet_reader_init(&reader, &apdu[apdu_len - 1], 1);
+    zassert_true(bacnet_reader_skip(&reader) < 0, NULL);
+    zassert_true(bacnet_reader_closing(&reader, 4), NULL);
+    /* a missing closing tag is an error */
+    bacnet_reader_init(&reader, &apdu[apdu_len - 4], 3);
+    zassert_false(bacnet_reader_enclosed(&reader, 4, NULL, NULL), NULL);
+    zassert_true(bacnet_reader_error(&reader), NULL);
+    /* a mismatched closing tag is an error */
+    apdu[apdu_len - 1] = apdu[apdu_len - 1] + 0x10;
+    bacnet_reader_init(&reader, &apdu[apdu_len - 4], 4);
+    zassert_true(bacnet_reader_skip(&reader) < 0, NULL);
+    zassert_true(bacnet_reader_error(&reader), NULL);
+    /* primitive data that does not fit in the buffer is an error */
+    bacnet_reader_init(&reader, apdu, 3);
+    zassert_is_null(bacnet_reader_peek(&reader), NULL);
+    zassert_true(bacnet_reader_error(&reader), NULL);
+    zassert_false(bacnet_reader_advance(&reader, 1), NULL);
+    /* advance hands off to other decoders */
+    bacnet_reader_init(&reader, apdu, apdu_len);
+    zassert_true(bacnet_reader_advance(&reader, 5), NULL);
+    zassert_equal(bacnet_reader_data(&reader), &apdu[5], NULL);
+    zassert_false(bacnet_reader_advance(&reader, apdu_len), NULL);
+    zassert_true(bacnet_reader_error(&reader), NULL);
+    /* empty reader */
+    bacnet_reader_init(&reader, NULL, apdu_len);
+    zassert_equal(bacnet_reader_remaining(&reader), 0, NULL);
+    zassert_is_null(bacnet_reader_peek(&reader), NULL);
+    zassert_false(bacnet_reader_error(&reader), NULL);
+}
+
 #if defined(CONFIG_ZTEST_NEW_API)
 ZTEST(bacdcode_tests, test_octet_string_buffer)
 #else
@@ -2762,6 +2901,7 @@ void test_main(void)
         ztest_unit_test(testBACDCodeDouble),
         ztest_unit_test(test_bacnet_array_encode),
         ztest_unit_test(test_bacnet_enclosed_data_length),
+        ztest_unit_test(test_bacnet_reader),
         ztest_unit_test(test_octet_string_buffer),
         ztest_unit_test(test_bacnet_character_string_buffer),
         ztest_unit_test(test_bacnet_character_string_ansi),
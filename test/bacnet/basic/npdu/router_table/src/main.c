@@ -0,0 +1,228 @@
+/**
+ * @file
+ * @brief test the BACnet router routing table API
+ * @author Steve Karg <skarg@users.sourceforge.net>
+ * @date 2026
+ * @copyright SPDX-License-Identifier: MIT
+ */
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <bacnet/basic/npdu/router_table.h>
+
+/**
+ * @addtogroup bacnet_tests
+ * @{
+ */
+
+static void test_address_init(BACNET_ADDRESS *addr, uint8_t mac)
+{
+    memset(addr, 0, sizeof(BACNET_ADDRESS));
+    addr->mac_len = 1;
+    addr->mac[0] = mac;
+}
+
+/**
+ * @brief Test the directly connected ports
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(router_table_tests, test_router_table_ports)
+#else
+static void test_router_table_ports(void)
+#endif
+{
+    BACNET_ROUTER_TABLE table;
+    BACNET_ROUTER_TABLE_PORT *port;
+    BACNET_ADDRESS addr;
+    int index;
+
+    bacnet_router_table_init(&table);
+    test_address_init(&addr, 1);
+    index = bacnet_router_table_port_add(&table, 1, &addr, &table);
+    zassert_equal(index, 0, NULL);
+    test_address_init(&addr, 2);
+    index = bacnet_router_table_port_add(&table, 2, &addr, NULL);
+    zassert_equal(index, 1, NULL);
+    /* same network is the same port */
+    index = bacnet_router_table_port_add(&table, 2, &addr, NULL);
+    zassert_equal(index, 1, NULL);
+    /* invalid networks */
+    index = bacnet_router_table_port_add(&table, 0, &addr, NULL);
+    zassert_equal(index, -1, NULL);
+    index = bacnet_router_table_port_add(
+        &table, BACNET_BROADCAST_NETWORK, &addr, NULL);
+    zassert_equal(index, -1, NULL);
+    zassert_equal(bacnet_router_table_port_count(&table), 2, NULL);
+    port = bacnet_router_table_port_find(&table, 1);
+    zassert_not_null(port, NULL);
+    zassert_equal(port->net, 1, NULL);
+    zassert_equal(port->mac_len, 1, NULL);
+    zassert_equal(port->mac[0], 1, NULL);
+    zassert_equal(port->context, &table, NULL);
+    zassert_true(port->enabled, NULL);
+    zassert_equal(bacnet_router_table_port(&table, 1)->net, 2, NULL);
+    zassert_is_null(bacnet_router_table_port(&table, 2), NULL);
+    zassert_is_null(bacnet_router_table_port_find(&table, 3), NULL);
+    zassert_equal(bacnet_router_table_dnet_count(&table), 2, NULL);
+    bacnet_router_table_cleanup(&table);
+    zassert_equal(bacnet_router_table_port_count(&table), 0, NULL);
+}
+
+/**
+ * @brief Test the routes to remote networks
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(router_table_tests, test_router_table_routes)
+#else
+static void test_router_table_routes(void)
+#endif
+{
+    BACNET_ROUTER_TABLE table;
+    BACNET_ROUTER_TABLE_PORT *port;
+    BACNET_ROUTER_TABLE_ENTRY *entry;
+    BACNET_ADDRESS addr, dest;
+    unsigned cursor = 0, count = 0;
+    uint16_t net;
+    bool status;
+
+    bacnet_router_table_init(&table);
+    bacnet_router_table_port_add(&table, 1, NULL, NULL);
+    bacnet_router_table_port_add(&table, 2, NULL, NULL);
+    /* a large number of networks behind port 2 */
+    for (net = 100; net < 1100; net++) {
+        test_address_init(&addr, (uint8_t)net);
+        status = bacnet_router_table_dnet_add(&table, 2, net, &addr);
+        zassert_true(status, NULL);
+    }
+    zassert_equal(bacnet_router_table_dnet_count(&table), 1002, NULL);
+    for (net = 100; net < 1100; net++) {
+        memset(&dest, 0, sizeof(dest));
+        port = bacnet_router_table_route(&table, net, &dest);
+        zassert_not_null(port, NULL);
+        zassert_equal(port->net, 2, NULL);
+        zassert_equal(dest.mac_len, 1, NULL);
+        zassert_equal(dest.mac[0], (uint8_t)net, NULL);
+    }
+    /* directly connected network does not fill the address */
+    memset(&dest, 0, sizeof(dest));
+    port = bacnet_router_table_route(&table, 1, &dest);
+    zassert_not_null(port, NULL);
+    zassert_equal(port->net, 1, NULL);
+    zassert_equal(dest.mac_len, 0, NULL);
+    /* unknown network, unknown port, and directly connected network */
+    zassert_is_null(bacnet_router_table_route(&table, 5000, NULL), NULL);
+    zassert_false(bacnet_router_table_dnet_add(&table, 3, 5000, NULL), NULL);
+    zassert_false(bacnet_router_table_dnet_add(&table, 2, 1, NULL), NULL);
+    /* a route update moves the network to another port */
+    zassert_true(bacnet_router_table_dnet_add(&table, 1, 500, NULL), NULL);
+    port = bacnet_router_table_route(&table, 500, NULL);
+    zassert_equal(port->net, 1, NULL);
+    /* iterate */
+    while ((entry = bacnet_router_table_dnet_next(&table, &cursor))) {
+        count++;
+    }
+    zassert_equal(count, 1002, NULL);
+    /* remove every other network, the others are still found */
+    for (net = 100; net < 1100; net += 2) {
+        zassert_true(bacnet_router_table_dnet_remove(&table, net), NULL);
+    }
+    zassert_false(bacnet_router_table_dnet_remove(&table, 100), NULL);
+    zassert_false(bacnet_router_table_dnet_remove(&table, 1), NULL);
+    zassert_equal(bacnet_router_table_dnet_count(&table), 502, NULL);
+    for (net = 100; net < 1100; net++) {
+        entry = bacnet_router_table_dnet_find(&table, net);
+        if (net & 1) {
+            zassert_not_null(entry, NULL);
+            zassert_equal(entry->net, net, NULL);
+        } else {
+            zassert_is_null(entry, NULL);
+        }
+    }
+    bacnet_router_table_cleanup(&table);
+}
+
+/**
+ * @brief Test the reachability status of networks
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(router_table_tests, test_router_table_status)
+#else
+static void test_router_table_status(void)
+#endif
+{
+    BACNET_ROUTER_TABLE table;
+
+    bacnet_router_table_init(&table);
+    bacnet_router_table_port_add(&table, 1, NULL, NULL);
+    bacnet_router_table_dnet_add(&table, 1, 10, NULL);
+    zassert_equal(
+        bacnet_router_table_status(&table, 10), BACNET_ROUTER_TABLE_REACHABLE,
+        NULL);
+    zassert_true(
+        bacnet_router_table_status_set(&table, 10, BACNET_ROUTER_TABLE_BUSY),
+        NULL);
+    zassert_equal(
+        bacnet_router_table_status(&table, 10), BACNET_ROUTER_TABLE_BUSY, NULL);
+    /* learning the route again makes it reachable */
+    bacnet_router_table_dnet_add(&table, 1, 10, NULL);
+    zassert_equal(
+        bacnet_router_table_status(&table, 10), BACNET_ROUTER_TABLE_REACHABLE,
+        NULL);
+    zassert_false(
+        bacnet_router_table_status_set(&table, 11, BACNET_ROUTER_TABLE_BUSY),
+        NULL);
+    zassert_equal(
+        bacnet_router_table_status(&table, 11),
+        BACNET_ROUTER_TABLE_UNREACHABLE, NULL);
+    bacnet_router_table_cleanup(&table);
+}
+
+/**
+ * @brief Test the cached broadcast fan-out lists
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(router_table_tests, test_router_table_broadcast)
+#else
+static void test_router_table_broadcast(void)
+#endif
+{
+    BACNET_ROUTER_TABLE table;
+    const uint8_t *list;
+    unsigned count = 0;
+
+    bacnet_router_table_init(&table);
+    bacnet_router_table_port_add(&table, 1, NULL, NULL);
+    bacnet_router_table_port_add(&table, 2, NULL, NULL);
+    bacnet_router_table_port_add(&table, 3, NULL, NULL);
+    list = bacnet_router_table_broadcast_ports(&table, 2, &count);
+    zassert_equal(count, 2, NULL);
+    zassert_equal(list[0], 0, NULL);
+    zassert_equal(list[1], 2, NULL);
+    list = bacnet_router_table_broadcast_ports(&table, 0, &count);
+    zassert_equal(count, 3, NULL);
+    zassert_true(bacnet_router_table_port_enabled_set(&table, 2, false), NULL);
+    list = bacnet_router_table_broadcast_ports(&table, 2, &count);
+    zassert_equal(count, 1, NULL);
+    zassert_equal(list[0], 0, NULL);
+    list = bacnet_router_table_broadcast_ports(&table, 0, &count);
+    zassert_equal(count, 2, NULL);
+    zassert_false(bacnet_router_table_port_enabled_set(&table, 3, false), NULL);
+    bacnet_router_table_cleanup(&table);
+}
+/**
+ * @}
+ */
+
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST_SUITE(router_table_tests, NULL, NULL, NULL, NULL, NULL);
+#else
+void test_main(void)
+{
+    ztest_test_suite(
+        router_table_tests, ztest_unit_test(test_router_table_ports),
+        ztest_unit_test(test_router_table_routes),
+        ztest_unit_test(test_router_table_status),
+        ztest_unit_test(test_router_table_broadcast));
+
+    ztest_run_test_suite(router_table_tests);
+}
+#endif
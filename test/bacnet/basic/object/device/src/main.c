@@ -132,6 +132,98 @@ static void test_Routed_Device_DCC_Remains_Blocked(void)
     status = Set_Routed_Device_Object_Index(0);
     zassert_true(status, NULL);
 }
+
+/**
+ * @brief Verify the routed device lookups by instance and virtual MAC.
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(device_tests, test_Routed_Device_Lookup)
+#else
+static void test_Routed_Device_Lookup(void)
+#endif
+{
+    BACNET_ADDRESS address = { 0 };
+    BACNET_ADDRESS dest = { 0 };
+    int32_t dnet_list[2] = { 99, -1 };
+    uint16_t device_index = 0;
+    uint16_t i = 0;
+    int cursor = 0;
+    int index = 0;
+    bool status = false;
+
+    Device_Init(NULL);
+    Routing_Device_Init(1000);
+    for (i = 1; i < MAX_NUM_DEVICES; i++) {
+        device_index = Add_Routed_Device(2000 + i, NULL, NULL);
+        zassert_equal(device_index, i, NULL);
+        address.net = 99;
+        address.len = 3;
+        encode_unsigned24(&address.adr[0], 2000 + i);
+        status = Routed_Device_Set_Address(i, &address);
+        zassert_true(status, NULL);
+    }
+    zassert_equal(Get_Num_Managed_Devices(), MAX_NUM_DEVICES, NULL);
+    device_index = Add_Routed_Device(9999, NULL, NULL);
+    zassert_equal(device_index, UINT16_MAX, NULL);
+    zassert_false(Routed_Device_Set_Address(MAX_NUM_DEVICES, &address), NULL);
+    /* lookups do not change the current device */
+    status = Set_Routed_Device_Object_Index(0);
+    zassert_true(status, NULL);
+    zassert_equal(Routed_Device_Instance_Index(1000), 0, NULL);
+    for (i = 1; i < MAX_NUM_DEVICES; i++) {
+        zassert_equal(Routed_Device_Instance_Index(2000 + i), i, NULL);
+        encode_unsigned24(&address.adr[0], 2000 + i);
+        zassert_equal(Routed_Device_Address_Index(3, address.adr), i, NULL);
+    }
+    zassert_equal(Routed_Device_Instance_Index(9999), -1, NULL);
+    encode_unsigned24(&address.adr[0], 9999);
+    zassert_equal(Routed_Device_Address_Index(3, address.adr), -1, NULL);
+    zassert_equal(Routed_Device_Object_Index(), 0, NULL);
+    /* unicast to a virtual device on the virtual network */
+    dest.net = 99;
+    dest.len = 3;
+    encode_unsigned24(&dest.adr[0], 2000 + MAX_NUM_DEVICES - 1);
+    status = Routed_Device_Find_Next(&dest, dnet_list, &cursor, &device_index);
+    zassert_true(status, NULL);
+    zassert_equal(device_index, MAX_NUM_DEVICES - 1, NULL);
+    zassert_equal(cursor, -1, NULL);
+    zassert_equal(Routed_Device_Object_Index(), 0, NULL);
+    cursor = 0;
+    status = Routed_Device_GetNext(&dest, dnet_list, &cursor);
+    zassert_true(status, NULL);
+    zassert_equal(Routed_Device_Object_Index(), MAX_NUM_DEVICES - 1, NULL);
+    /* unknown virtual MAC */
+    cursor = 0;
+    encode_unsigned24(&dest.adr[0], 9999);
+    status = Routed_Device_Find_Next(&dest, dnet_list, &cursor, &device_index);
+    zassert_false(status, NULL);
+    zassert_equal(cursor, -1, NULL);
+    /* broadcast on the virtual network reaches every routed device */
+    dest.len = 0;
+    cursor = 0;
+    index = 0;
+    while (Routed_Device_Find_Next(&dest, dnet_list, &cursor, &device_index)) {
+        index++;
+        zassert_equal(device_index, index, NULL);
+    }
+    zassert_equal(index, MAX_NUM_DEVICES - 1, NULL);
+    /* a new instance number is found by the lookup */
+    status = Set_Routed_Device_Object_Index(1);
+    zassert_true(status, NULL);
+    status = Routed_Device_Set_Object_Instance_Number(4000);
+    zassert_true(status, NULL);
+    zassert_equal(Routed_Device_Instance_Index(4000), 1, NULL);
+    zassert_equal(Routed_Device_Instance_Index(2001), -1, NULL);
+    zassert_true(Routed_Device_Valid_Object_Instance_Number(4000), NULL);
+    zassert_false(Routed_Device_Valid_Object_Instance_Number(2001), NULL);
+    /* a new address is found by the lookup */
+    encode_unsigned24(&address.adr[0], 4000);
+    status = Routed_Device_Set_Address(1, &address);
+    zassert_true(status, NULL);
+    zassert_equal(Routed_Device_Address_Index(3, address.adr), 1, NULL);
+    status = Set_Routed_Device_Object_Index(0);
+    zassert_true(status, NULL);
+}
 #endif
 
 /**
@@ -662,6 +754,7 @@ void test_main(void)
         device_tests, ztest_unit_test(testDevice),
         ztest_unit_test(test_Device_Data_Sharing),
         ztest_unit_test(test_Routed_Device_DCC_Remains_Blocked),
+        ztest_unit_test(test_Routed_Device_Lookup),
         ztest_unit_test(test_Routed_Device_Reinitialize),
         ztest_unit_test(test_Routed_Device_Backup_Restore_Independence),
         ztest_unit_test(test_Routed_Device_Backup_Countdown_Per_Device));
@@ -670,6 +763,7 @@ void test_main(void)
         device_tests, ztest_unit_test(testDevice),
         ztest_unit_test(test_Device_Data_Sharing),
         ztest_unit_test(test_Routed_Device_DCC_Remains_Blocked),
+        ztest_unit_test(test_Routed_Device_Lookup),
         ztest_unit_test(test_Routed_Device_Reinitialize));
 #else
     ztest_test_suite(
@@ -173,6 +173,31 @@ void bacnet_object_property_write_parameter_init(
     }
 }
 
+/**
+ * @brief Check that a size query, if supported by the object, returns
+ *  the same length as the read that encoded the value.
+ * @param rpdata [in] The read property request that was performed
+ * @param read_property [in] The function to read the property
+ * @param read_len [in] The length returned by the read
+ */
+static void property_size_query_test(
+    const BACNET_READ_PROPERTY_DATA *rpdata,
+    read_property_function read_property,
+    int read_len)
+{
+    BACNET_READ_PROPERTY_DATA query = *rpdata;
+    int len = 0;
+
+    query.application_data = NULL;
+    len = read_property(&query);
+    if (len != 0) {
+        /* zero means the size query mode is not supported */
+        zassert_equal(
+            len, read_len, "property '%s': size query %d!=%d",
+            bactext_property_name(rpdata->object_property), len, read_len);
+    }
+}
+
 /**
  * @brief Perform a read/write test on a property
  * @param rpdata [in,out] The structure to hold the read property request
@@ -203,6 +228,7 @@ int bacnet_object_property_read_test(
         (rpdata->error_code == ERROR_CODE_READ_ACCESS_DENIED)) {
         /* read-only is a valid response for some properties */
     } else if (read_len > 0) {
+        property_size_query_test(rpdata, read_property, read_len);
         /* validate the data from the read request */
         apdu = rpdata->application_data;
         apdu_len = read_len;
@@ -7,6 +7,7 @@
  * @copyright SPDX-License-Identifier: MIT
  */
 #include <stdio.h>
+#include <time.h>
 #include <zephyr/ztest.h>
 #include <bacnet/bacdef.h>
 #include <bacnet/basic/program/ubasic/ubasic.h>
@@ -484,6 +485,166 @@ static void test_ubasic(void)
 
     return;
 }
+/**
+ * @brief Run a program until it is finished
+ * @param data - ubasic data structure
+ * @return number of times the program was run
+ */
+static unsigned test_ubasic_run(struct ubasic_data *data)
+{
+    unsigned count = 0;
+
+    while (!ubasic_finished(data)) {
+        ubasic_run_program(data);
+        count++;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Test that a compiled program runs the same as the program text
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(ubasic_tests, test_ubasic_compile)
+#else
+static void test_ubasic_compile(void)
+#endif
+{
+    struct ubasic_data data = { 0 };
+    struct ubasic_bytecode code[256] = { 0 };
+    const char *program =
+        "a = 0; b = 0; c = 0; d = 16; e = 2.5; f = 0x10;"
+        "for i = 1 to 5;"
+        "  gosub add_a;"
+        "  if i > 3 then b = b + 1;"
+        "  if i <= 3 then c = c + 1;"
+        "next i;"
+        "while d > 0;"
+        "  d = d - 4;"
+        "  if d == 8 then;"
+        "    c = c + 10;"
+        "  else;"
+        "    c = c + 100;"
+        "  endif;"
+        "endwhile;"
+        "s$ = left$(\"abcdef\", 3);"
+        "goto done;"
+        "a = 1000;"
+        ":add_a a = a + e;"
+        "return;"
+        ":done end;";
+    char text_str[UBASIC_STRINGLEN_MAX] = { 0 };
+    UBASIC_VARIABLE_TYPE text_value[5];
+    unsigned text_count, count;
+    uint16_t code_len;
+    const char *s;
+
+    data.serial_write = serial_write;
+    ubasic_load_program(&data, program);
+    text_count = test_ubasic_run(&data);
+    zassert_equal(data.status.bit.Error, 0, NULL);
+    text_value[0] = ubasic_get_variable(&data, 'a');
+    text_value[1] = ubasic_get_variable(&data, 'b');
+    text_value[2] = ubasic_get_variable(&data, 'c');
+    text_value[3] = ubasic_get_variable(&data, 'd');
+    text_value[4] = ubasic_get_variable(&data, 'f');
+    snprintf(
+        text_str, sizeof(text_str), "%s", ubasic_ptr_stringvariable(&data, 's'));
+    zassert_equal(fixedpt_toint(text_value[0]), 12, NULL);
+    zassert_equal(fixedpt_toint(text_value[1]), 2, NULL);
+    zassert_equal(fixedpt_toint(text_value[2]), 313, NULL);
+    zassert_equal(strcmp(text_str, "abc"), 0, NULL);
+
+    ubasic_clear_variables(&data);
+    code_len = ubasic_compile_program(&data, program, code, ARRAY_SIZE(code));
+    zassert_true(code_len > 0, NULL);
+    zassert_equal(code[code_len - 1].token, UBASIC_TOKENIZER_ENDOFINPUT, NULL);
+    zassert_equal(data.status.bit.isRunning, 1, NULL);
+    count = test_ubasic_run(&data);
+    zassert_equal(data.status.bit.Error, 0, NULL);
+    zassert_equal(count, text_count, NULL);
+    zassert_equal(ubasic_get_variable(&data, 'a'), text_value[0], NULL);
+    zassert_equal(ubasic_get_variable(&data, 'b'), text_value[1], NULL);
+    zassert_equal(ubasic_get_variable(&data, 'c'), text_value[2], NULL);
+    zassert_equal(ubasic_get_variable(&data, 'd'), text_value[3], NULL);
+    zassert_equal(ubasic_get_variable(&data, 'f'), text_value[4], NULL);
+    s = ubasic_ptr_stringvariable(&data, 's');
+    zassert_equal(strcmp(s, text_str), 0, NULL);
+    /* loading the program again keeps the compiled program */
+    ubasic_clear_variables(&data);
+    ubasic_load_program(&data, NULL);
+    zassert_true(data.code == code, NULL);
+    count = test_ubasic_run(&data);
+    zassert_equal(count, text_count, NULL);
+    zassert_equal(ubasic_get_variable(&data, 'c'), text_value[2], NULL);
+    /* a program that does not fit runs from the program text */
+    ubasic_clear_variables(&data);
+    code_len = ubasic_compile_program(&data, program, code, 8);
+    zassert_equal(code_len, 0, NULL);
+    zassert_is_null(data.code, NULL);
+    count = test_ubasic_run(&data);
+    zassert_equal(count, text_count, NULL);
+    zassert_equal(ubasic_get_variable(&data, 'c'), text_value[2], NULL);
+    /* a goto to an unknown label ends the program */
+    ubasic_clear_variables(&data);
+    code_len = ubasic_compile_program(
+        &data, "a = 1; goto nowhere; a = 2;", code, ARRAY_SIZE(code));
+    zassert_true(code_len > 0, NULL);
+    test_ubasic_run(&data);
+    zassert_equal(fixedpt_toint(ubasic_get_variable(&data, 'a')), 1, NULL);
+}
+
+/**
+ * @brief Compare the run time of the compiled program and the program text
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(ubasic_tests, test_ubasic_benchmark)
+#else
+static void test_ubasic_benchmark(void)
+#endif
+{
+    static struct ubasic_bytecode code[256];
+    struct ubasic_data data = { 0 };
+    const char *program =
+        "s = 0;"
+        "for i = 1 to 200;"
+        "  for j = 1 to 50;"
+        "    gosub accumulate;"
+        "  next j;"
+        "next i;"
+        "end;"
+        ":accumulate"
+        "  s = s + (i * 3 + j) % 7;"
+        "  if s > 10000 then s = s - 10000;"
+        "return;";
+    UBASIC_VARIABLE_TYPE text_value, value;
+    clock_t start, text_ticks, ticks;
+    unsigned text_count, count;
+
+    ubasic_load_program(&data, program);
+    start = clock();
+    text_count = test_ubasic_run(&data);
+    text_ticks = clock() - start;
+    zassert_equal(data.status.bit.Error, 0, NULL);
+    text_value = ubasic_get_variable(&data, 's');
+
+    ubasic_clear_variables(&data);
+    zassert_true(
+        ubasic_compile_program(&data, program, code, ARRAY_SIZE(code)) > 0,
+        NULL);
+    start = clock();
+    count = test_ubasic_run(&data);
+    ticks = clock() - start;
+    zassert_equal(data.status.bit.Error, 0, NULL);
+    value = ubasic_get_variable(&data, 's');
+    zassert_equal(value, text_value, NULL);
+    zassert_equal(count, text_count, NULL);
+    printf(
+        "uBASIC %u statements: text %.3f ms, compiled %.3f ms\n", count,
+        (double)text_ticks * 1000.0 / CLOCKS_PER_SEC,
+        (double)ticks * 1000.0 / CLOCKS_PER_SEC);
+}
 /**
  * @}
  */
@@ -496,7 +657,9 @@ void test_main(void)
     ztest_test_suite(
         ubasic_tests, ztest_unit_test(test_ubasic),
         ztest_unit_test(test_ubasic_strings), ztest_unit_test(test_ubasic_math),
-        ztest_unit_test(test_ubasic_bacnet), ztest_unit_test(test_ubasic_gpio));
+        ztest_unit_test(test_ubasic_bacnet), ztest_unit_test(test_ubasic_gpio),
+        ztest_unit_test(test_ubasic_compile),
+        ztest_unit_test(test_ubasic_benchmark));
 
     ztest_run_test_suite(ubasic_tests);
 }
@@ -8,6 +8,7 @@
 #include <zephyr/ztest.h>
 #include <stdlib.h>
 #include <bacnet/datalink/cobs.h>
+#include <bacnet/datalink/mstpdef.h>
 #include <bacnet/basic/sys/bytes.h>
 
 /**
@@ -49,6 +50,44 @@ static void test_COBS_Encode_Decode(void)
     zassert_true(
         test_buffer_length == sizeof(buffer), "COBS encode/decode length fail");
 }
+
+/**
+ * @brief Test the CRC-32K buffer API against the octet-at-a-time API
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(cobs_tests, test_COBS_CRC32K_Buffer)
+#else
+static void test_COBS_CRC32K_Buffer(void)
+#endif
+{
+    uint8_t buffer[64] = { 0 };
+    uint8_t crc_buffer[4] = { 0 };
+    uint32_t crc32K, crc32K_buffer;
+    size_t length, offset, i;
+
+    for (i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t)((i * 167) + 13);
+    }
+    /* every length and alignment around the eight octet stride */
+    for (offset = 0; offset < 8; offset++) {
+        for (length = 0; length <= (sizeof(buffer) - offset); length++) {
+            crc32K = CRC32K_INITIAL_VALUE;
+            for (i = 0; i < length; i++) {
+                crc32K = cobs_crc32k(buffer[offset + i], crc32K);
+            }
+            crc32K_buffer = cobs_crc32k_buffer(
+                &buffer[offset], length, CRC32K_INITIAL_VALUE);
+            zassert_equal(crc32K, crc32K_buffer, NULL);
+        }
+    }
+    /* appending the ones complement leaves the residue */
+    crc32K = cobs_crc32k_buffer(buffer, sizeof(buffer), CRC32K_INITIAL_VALUE);
+    (void)cobs_crc32k_encode(crc_buffer, sizeof(crc_buffer), ~crc32K);
+    crc32K = cobs_crc32k_buffer(crc_buffer, sizeof(crc_buffer), crc32K);
+    zassert_equal(crc32K, CRC32K_RESIDUE, NULL);
+    crc32K = cobs_crc32k_buffer(NULL, sizeof(buffer), crc32K);
+    zassert_equal(crc32K, CRC32K_RESIDUE, NULL);
+}
 /**
  * @}
  */
@@ -58,7 +97,9 @@ ZTEST_SUITE(cobs_tests, NULL, NULL, NULL, NULL, NULL);
 #else
 void test_main(void)
 {
-    ztest_test_suite(cobs_tests, ztest_unit_test(test_COBS_Encode_Decode));
+    ztest_test_suite(
+        cobs_tests, ztest_unit_test(test_COBS_Encode_Decode),
+        ztest_unit_test(test_COBS_CRC32K_Buffer));
 
     ztest_run_test_suite(cobs_tests);
 }
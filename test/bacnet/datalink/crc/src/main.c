@@ -73,6 +73,49 @@ static void testCRC16(void)
     zassert_equal(crc, 0xF0B8, NULL);
 }
 
+/**
+ * @brief Test the buffer CRC APIs against the octet-at-a-time APIs
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(crc_tests, testCRCBuffer)
+#else
+static void testCRCBuffer(void)
+#endif
+{
+    uint8_t buffer[64] = { 0 };
+    uint8_t header[5] = { 0x00, 0x10, 0x05, 0x00, 0x00 };
+    uint16_t crc16, crc16_buffer;
+    uint8_t crc8;
+    size_t length, offset, i;
+
+    /* Annex G 1.0 example */
+    crc8 = CRC_Calc_Header_Buffer(header, sizeof(header), 0xff);
+    zassert_equal(crc8, 0x73, NULL);
+    /* Annex G 2.0 example */
+    buffer[0] = 0x01;
+    buffer[1] = 0x22;
+    buffer[2] = 0x30;
+    crc16 = CRC_Calc_Data_Buffer(buffer, 3, 0xffff);
+    zassert_equal(crc16, 0x42EF, NULL);
+    crc16 = CRC_Calc_Data_Buffer(NULL, 3, crc16);
+    zassert_equal(crc16, 0x42EF, NULL);
+    for (i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t)((i * 167) + 13);
+    }
+    /* every length and alignment around the eight octet stride */
+    for (offset = 0; offset < 8; offset++) {
+        for (length = 0; length <= (sizeof(buffer) - offset); length++) {
+            crc16 = 0xffff;
+            for (i = 0; i < length; i++) {
+                crc16 = CRC_Calc_Data(buffer[offset + i], crc16);
+            }
+            crc16_buffer =
+                CRC_Calc_Data_Buffer(&buffer[offset], length, 0xffff);
+            zassert_equal(crc16, crc16_buffer, NULL);
+        }
+    }
+}
+
 /**
  * @brief "Test" to create/log generated CRC8 table
  */
@@ -139,6 +182,7 @@ void test_main(void)
 {
     ztest_test_suite(
         crc_tests, ztest_unit_test(testCRC8), ztest_unit_test(testCRC16),
+        ztest_unit_test(testCRCBuffer),
         ztest_unit_test(testCRC8CreateTable),
         ztest_unit_test(testCRC16CreateTable));
 
@@ -770,6 +770,195 @@ static void testReceiveNodeFSM_COBS_Large_Frame(void)
     }
 }
 
+/* one frame as reported by the receive state machine */
+struct receive_frame_result {
+    bool valid;
+    bool not_for_us;
+    bool invalid;
+    uint8_t frame_type;
+    uint8_t destination;
+    uint8_t source;
+    uint16_t data_length;
+    uint8_t data[MAX_MPDU];
+};
+
+static unsigned Receive_Frame_Take(
+    struct mstp_port_struct_t *mstp_port,
+    struct receive_frame_result *results,
+    unsigned count)
+{
+    struct receive_frame_result *result;
+
+    if (!mstp_port->ReceivedValidFrame &&
+        !mstp_port->ReceivedValidFrameNotForUs &&
+        !mstp_port->ReceivedInvalidFrame) {
+        return count;
+    }
+    result = &results[count];
+    result->valid = mstp_port->ReceivedValidFrame;
+    result->not_for_us = mstp_port->ReceivedValidFrameNotForUs;
+    result->invalid = mstp_port->ReceivedInvalidFrame;
+    result->frame_type = mstp_port->FrameType;
+    result->destination = mstp_port->DestinationAddress;
+    result->source = mstp_port->SourceAddress;
+    result->data_length = mstp_port->DataLength;
+    if (mstp_port->ReceivedValidFrame &&
+        (mstp_port->DataLength <= sizeof(result->data))) {
+        memcpy(result->data, mstp_port->InputBuffer, mstp_port->DataLength);
+    }
+    mstp_port->ReceivedValidFrame = false;
+    mstp_port->ReceivedValidFrameNotForUs = false;
+    mstp_port->ReceivedInvalidFrame = false;
+
+    return count + 1;
+}
+
+static void Receive_Frame_Port_Init(struct mstp_port_struct_t *mstp_port)
+{
+    memset(mstp_port, 0, sizeof(struct mstp_port_struct_t));
+    mstp_port->InputBuffer = &RxBuffer[0];
+    mstp_port->InputBufferSize = sizeof(RxBuffer);
+    mstp_port->OutputBuffer = &TxBuffer[0];
+    mstp_port->OutputBufferSize = sizeof(TxBuffer);
+    mstp_port->SilenceTimer = Timer_Silence;
+    mstp_port->SilenceTimerReset = Timer_Silence_Reset;
+    mstp_port->This_Station = 0x05;
+    mstp_port->Nmax_info_frames = 1;
+    mstp_port->Nmax_master = 127;
+    MSTP_Init(mstp_port);
+}
+
+static void testReceiveFrameBuffer(void)
+{
+    static struct receive_frame_result expected[8];
+    static struct receive_frame_result results[8];
+    static uint8_t stream[MAX_MPDU * 6];
+    struct mstp_port_struct_t mstp_port = { 0 };
+    uint8_t data[MAX_PDU] = { 0 };
+    uint8_t cobs_data[Nmin_COBS_length_BACnet] = { 0 };
+    const size_t chunk_sizes[] = { 1, 3, 7, 64, sizeof(stream) };
+    size_t stream_len = 0, offset, len, chunk, i;
+    unsigned expected_count = 0, count, n;
+
+    for (i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i * 7);
+    }
+    for (i = 0; i < sizeof(cobs_data); i++) {
+        cobs_data[i] = (uint8_t)i;
+    }
+    /* line noise, including a lone preamble octet */
+    stream[stream_len++] = 0x00;
+    stream[stream_len++] = 0x55;
+    stream[stream_len++] = 0x12;
+    stream[stream_len++] = 0xFF;
+    /* token for us */
+    stream_len += MSTP_Create_Frame(
+        &stream[stream_len], sizeof(stream) - stream_len, FRAME_TYPE_TOKEN,
+        0x05, 0x01, NULL, 0);
+    /* data for us */
+    stream_len += MSTP_Create_Frame(
+        &stream[stream_len], sizeof(stream) - stream_len,
+        FRAME_TYPE_BACNET_DATA_NOT_EXPECTING_REPLY, 0x05, 0x02, data, 200);
+    /* data not for us */
+    stream_len += MSTP_Create_Frame(
+        &stream[stream_len], sizeof(stream) - stream_len,
+        FRAME_TYPE_BACNET_DATA_EXPECTING_REPLY, 0x09, 0x02, data, 50);
+    /* data with a bad CRC */
+    len = MSTP_Create_Frame(
+        &stream[stream_len], sizeof(stream) - stream_len,
+        FRAME_TYPE_BACNET_DATA_NOT_EXPECTING_REPLY, 0x05, 0x02, data, 10);
+    stream[stream_len + 8 + 3] ^= 0x01;
+    stream_len += len;
+    /* a header with a bad CRC */
+    len = MSTP_Create_Frame(
+        &stream[stream_len], sizeof(stream) - stream_len,
+        FRAME_TYPE_POLL_FOR_MASTER, 0x05, 0x03, NULL, 0);
+    stream[stream_len + 7] ^= 0x01;
+    stream_len += len;
+    /* COBS encoded data for us */
+    stream_len += MSTP_Create_Frame(
+        &stream[stream_len], sizeof(stream) - stream_len,
+        FRAME_TYPE_BACNET_EXTENDED_DATA_NOT_EXPECTING_REPLY, 0x05, 0x04,
+        cobs_data, sizeof(cobs_data));
+    /* the largest data frame for us */
+    stream_len += MSTP_Create_Frame(
+        &stream[stream_len], sizeof(stream) - stream_len,
+        FRAME_TYPE_BACNET_DATA_EXPECTING_REPLY, 0x05, 0x06, data,
+        MSTP_FRAME_NPDU_MAX);
+    zassert_true(stream_len < sizeof(stream), NULL);
+
+    /* an octet at a time through the receive state machine */
+    Receive_Frame_Port_Init(&mstp_port);
+    for (i = 0; i < stream_len; i++) {
+        mstp_port.DataRegister = stream[i];
+        mstp_port.DataAvailable = true;
+        while (mstp_port.DataAvailable) {
+            MSTP_Receive_Frame_FSM(&mstp_port);
+            expected_count =
+                Receive_Frame_Take(&mstp_port, expected, expected_count);
+        }
+    }
+    zassert_equal(expected_count, 7, NULL);
+    zassert_true(expected[0].valid, NULL);
+    zassert_equal(expected[0].frame_type, FRAME_TYPE_TOKEN, NULL);
+    zassert_true(expected[1].valid, NULL);
+    zassert_equal(expected[1].data_length, 200, NULL);
+    zassert_true(expected[2].not_for_us, NULL);
+    zassert_true(expected[3].invalid, NULL);
+    zassert_true(expected[4].invalid, NULL);
+    zassert_true(expected[5].valid, NULL);
+    zassert_equal(expected[5].data_length, sizeof(cobs_data), NULL);
+    zassert_true(expected[6].valid, NULL);
+    zassert_equal(expected[6].data_length, MSTP_FRAME_NPDU_MAX, NULL);
+    /* the same frames from blocks of octets */
+    for (n = 0; n < ARRAY_SIZE(chunk_sizes); n++) {
+        Receive_Frame_Port_Init(&mstp_port);
+        memset(results, 0, sizeof(results));
+        count = 0;
+        for (offset = 0; offset < stream_len; offset += chunk) {
+            chunk = chunk_sizes[n];
+            if (chunk > (stream_len - offset)) {
+                chunk = stream_len - offset;
+            }
+            i = 0;
+            while (i < chunk) {
+                i += MSTP_Receive_Frame_Buffer(
+                    &mstp_port, &stream[offset + i], chunk - i);
+                count = Receive_Frame_Take(&mstp_port, results, count);
+            }
+        }
+        zassert_equal(count, expected_count, "chunk=%u", chunk_sizes[n]);
+        for (i = 0; i < count; i++) {
+            zassert_equal(results[i].valid, expected[i].valid, NULL);
+            zassert_equal(
+                results[i].not_for_us, expected[i].not_for_us, NULL);
+            zassert_equal(results[i].invalid, expected[i].invalid, NULL);
+            zassert_equal(
+                results[i].frame_type, expected[i].frame_type, NULL);
+            zassert_equal(
+                results[i].destination, expected[i].destination, NULL);
+            zassert_equal(results[i].source, expected[i].source, NULL);
+            zassert_equal(
+                results[i].data_length, expected[i].data_length, NULL);
+            zassert_mem_equal(
+                results[i].data, expected[i].data, sizeof(results[i].data),
+                NULL);
+        }
+        zassert_equal(mstp_port.receive_state, MSTP_RECEIVE_STATE_IDLE, NULL);
+    }
+    /* a silent line times out a partial frame */
+    Receive_Frame_Port_Init(&mstp_port);
+    len = MSTP_Receive_Frame_Buffer(&mstp_port, &stream[4], 5);
+    zassert_equal(len, 5, NULL);
+    zassert_equal(mstp_port.receive_state, MSTP_RECEIVE_STATE_HEADER, NULL);
+    SilenceTime = mstp_port.Tframe_abort + 1;
+    len = MSTP_Receive_Frame_Buffer(&mstp_port, &stream[9], 3);
+    zassert_equal(len, 0, NULL);
+    zassert_true(mstp_port.ReceivedInvalidFrame, NULL);
+    zassert_equal(mstp_port.receive_state, MSTP_RECEIVE_STATE_IDLE, NULL);
+    zassert_equal(MSTP_Receive_Frame_Buffer(NULL, stream, 1), 0, NULL);
+}
+
 static void testSlaveNodeFSM(void)
 {
     struct mstp_port_struct_t MSTP_Port = { 0 }; /* port data */
@@ -1493,6 +1682,7 @@ void test_main(void)
         crc_tests, ztest_unit_test(testReceiveNodeFSM),
         ztest_unit_test(testReceiveNodeFSM_COBS_Decode_TightBuffer),
         ztest_unit_test(testReceiveNodeFSM_COBS_Large_Frame),
+        ztest_unit_test(testReceiveFrameBuffer),
         ztest_unit_test(testMasterNodeFSM), ztest_unit_test(testSlaveNodeFSM),
         ztest_unit_test(testZeroConfigNodeFSM),
         ztest_unit_test(testAutoBaudNodeFSM));
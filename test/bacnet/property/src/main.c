@@ -455,6 +455,68 @@ static void testPropListBACnetList(void)
         "proprietary properties should be considered BACnetLIST members");
 }
 
+/**
+ * @brief Test the property list index membership bitsets
+ */
+#if defined(CONFIG_ZTEST_NEW_API)
+ZTEST(property_tests, testPropListIndex)
+#else
+static void testPropListIndex(void)
+#endif
+{
+    static const int32_t proprietary[] = { PROP_PROPRIETARY_RANGE_MIN,
+                                           PROP_AUTHORIZATION_STATUS, -1 };
+    struct special_property_list_t property_list = { 0 };
+    struct property_list_index_t index = { 0 };
+    unsigned i = 0;
+    int32_t property = 0;
+    bool status = false;
+
+    for (i = 0; i < OBJECT_PROPRIETARY_MIN; i++) {
+        property_list_special((BACNET_OBJECT_TYPE)i, &property_list);
+        property_list_index_init(
+            &index, property_list.Required.pList, property_list.Optional.pList,
+            proprietary);
+        zassert_equal(
+            index.Lists.Required.count, property_list.Required.count, NULL);
+        zassert_equal(
+            index.Lists.Optional.count, property_list.Optional.count, NULL);
+        zassert_equal(index.Lists.Proprietary.count, 2, NULL);
+        zassert_true(
+            property_list_index_same(
+                &index, property_list.Required.pList,
+                property_list.Optional.pList, proprietary),
+            NULL);
+        zassert_false(
+            property_list_index_same(
+                &index, property_list.Required.pList,
+                property_list.Optional.pList, NULL),
+            NULL);
+        for (property = 0; property <= PROP_PROPRIETARY_RANGE_MIN + 1;
+             property++) {
+            status = property_lists_member(
+                property_list.Required.pList, property_list.Optional.pList,
+                proprietary, property);
+            zassert_equal(
+                property_list_index_member(&index, property), status,
+                "%s: property %d", bactext_object_type_name(i), property);
+        }
+        zassert_true(
+            property_list_index_member(&index, PROP_AUTHORIZATION_STATUS),
+            NULL);
+        zassert_false(
+            property_list_index_member(&index, PROP_PROPRIETARY_RANGE_MAX),
+            NULL);
+        zassert_false(property_list_index_member(&index, -1), NULL);
+    }
+    /* without extended members, no list is searched */
+    property_list_index_init(&index, NULL, NULL, NULL);
+    zassert_false(index.Extended, NULL);
+    zassert_equal(index.Lists.Required.count, 0, NULL);
+    zassert_false(property_list_index_member(&index, PROP_OBJECT_NAME), NULL);
+    zassert_false(property_list_index_member(NULL, PROP_OBJECT_NAME), NULL);
+}
+
 /**
  * @}
  */
@@ -468,7 +530,8 @@ void test_main(void)
         property_tests, ztest_unit_test(testPropList),
         ztest_unit_test(testPropListCommon),
         ztest_unit_test(testPropListEncode),
-        ztest_unit_test(testPropListBACnetList));
+        ztest_unit_test(testPropListBACnetList),
+        ztest_unit_test(testPropListIndex));
 
     ztest_run_test_suite(property_tests);
 }